@@ -0,0 +1,154 @@
+#ifndef COMPOSITE_SURVIVAL_HPP_INCLUDE_GUARD
+#define COMPOSITE_SURVIVAL_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "config.hpp"
+#include "PiecewiseHazardSurvival.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class implements the 'pdg::Survival' protocol for a system failing from any of
+// several independent causes, e.g. default, prepayment and mortality, each modeled by
+// a component curve: the survival probability is the product of those of the
+// components, and the hazard rate and cumulative hazard are the sums of theirs.
+// The components of type 'pdg::PiecewiseHazardSurvival', but not of a class derived
+// from it, are merged at construction into a single piecewise constant hazard curve,
+// over the union of their knots, with the sum of their hazard rates: their
+// contribution costs one search over the merged knots, whatever their number. The
+// other components are evaluated one by one.
+class CompositeSurvival : public pdg::Survival
+{
+  // Merger of the piecewise components, if any.
+  std::optional<pdg::PiecewiseHazardSurvival> piecewise_;
+  // Other components.
+  std::vector<pdg::Survival const*>           generic_;
+
+public:
+  // Create a curve composing the specified 'components'. The behaviour is undefined
+  // unless the components are not null, and those which are not of type
+  // 'pdg::PiecewiseHazardSurvival' outlive this object.
+  explicit CompositeSurvival(std::vector<pdg::Survival const*> const& components);
+
+  // Return the number of components evaluated one by one, including the merger of the
+  // piecewise components, if any.
+  std::size_t evaluated_components() const noexcept;
+
+private:
+  pdg::Probability survival_prob_impl(pdg::Time const& T) const override;
+  double hazard_rate_impl(pdg::Time const& T) const override;
+  pdg::Probability conditional_survival_prob_impl(
+                          pdg::Time const& T, pdg::Time const& t) const override;
+  double cumulative_hazard_impl(pdg::Time const& T) const override;
+  void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                    double* result) const override;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // fill, sort, unique
+#include <cassert>
+#include <typeinfo>
+#include <utility>   // move
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+PDG_INLINE pdg::CompositeSurvival::CompositeSurvival(
+                          std::vector<pdg::Survival const*> const& components)
+{
+  std::vector<pdg::PiecewiseHazardSurvival const*> piecewise;
+  for (auto const component : components) {
+    assert( component );
+    // Classes derived from 'pdg::PiecewiseHazardSurvival' may override its functions.
+    if (typeid(*component) == typeid(pdg::PiecewiseHazardSurvival)) {
+      piecewise.push_back(static_cast<pdg::PiecewiseHazardSurvival const*>(component));
+    }
+    else {
+      generic_.push_back(component);
+    }
+  }
+  if (piecewise.empty()) return;
+
+  std::vector<pdg::Time> knots;
+  for (auto const p : piecewise) {
+    knots.insert(knots.end(), p->knots().begin(), p->knots().end());
+  }
+  std::sort(knots.begin(), knots.end());
+  knots.erase(std::unique(knots.begin(), knots.end()), knots.end());
+
+  // The hazard rates are right-continuous: the rate of a component at a merged knot
+  // is its rate until the next merged knot.
+  std::vector<double> hazards(knots.size(), 0);
+  for (auto const p : piecewise) {
+    for (std::size_t i = 0; i != knots.size(); ++i) {
+      hazards[i] += p->hazard_rate(knots[i]);
+    }
+  }
+  piecewise_.emplace(std::move(knots), std::move(hazards));
+}
+
+PDG_INLINE std::size_t pdg::CompositeSurvival::evaluated_components() const noexcept
+{
+  return generic_.size() + (piecewise_ ? 1 : 0);
+}
+
+PDG_INLINE pdg::Probability pdg::CompositeSurvival::survival_prob_impl(
+                                                          pdg::Time const& T) const
+{
+  pdg::Probability result = piecewise_ ? piecewise_->survival_prob(T) : 1;
+  for (auto const component : generic_) result *= component->survival_prob(T);
+  return result;
+}
+
+PDG_INLINE double pdg::CompositeSurvival::hazard_rate_impl(pdg::Time const& T) const
+{
+  double result = piecewise_ ? piecewise_->hazard_rate(T) : 0;
+  for (auto const component : generic_) result += component->hazard_rate(T);
+  return result;
+}
+
+PDG_INLINE pdg::Probability pdg::CompositeSurvival::conditional_survival_prob_impl(
+                                     pdg::Time const& T, pdg::Time const& t) const
+{
+  pdg::Probability result = piecewise_ ? piecewise_->conditional_survival_prob(T, t) : 1;
+  for (auto const component : generic_) {
+    result *= component->conditional_survival_prob(T, t);
+  }
+  return result;
+}
+
+PDG_INLINE double pdg::CompositeSurvival::cumulative_hazard_impl(
+                                                          pdg::Time const& T) const
+{
+  double result = piecewise_ ? piecewise_->cumulative_hazard(T) : 0;
+  for (auto const component : generic_) result += component->cumulative_hazard(T);
+  return result;
+}
+
+PDG_INLINE void pdg::CompositeSurvival::cumulative_hazard_batch_impl(
+                  pdg::Time const* T, std::size_t count, double* result) const
+{
+  if (piecewise_) {
+    piecewise_->cumulative_hazard(T, count, result);
+  }
+  else {
+    std::fill(result, result + count, 0.0);
+  }
+  if (generic_.empty()) return;
+
+  std::vector<double> component_result(count);
+  for (auto const component : generic_) {
+    component->cumulative_hazard(T, count, component_result.data());
+    for (std::size_t i = 0; i != count; ++i) result[i] += component_result[i];
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // COMPOSITE_SURVIVAL_HPP_INCLUDE_GUARD
@@ -0,0 +1,174 @@
+#ifndef DAY_INDEXED_SURVIVAL_HPP_INCLUDE_GUARD
+#define DAY_INDEXED_SURVIVAL_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+#include <vector>
+
+#include "config.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class implements the 'pdg::Survival' protocol by decorating another
+// implementation, the base curve, with a dense lookup table of its cumulative hazard
+// at every whole day from '0' to a horizon. Queries at a whole day within the horizon
+// are answered with one load from the table, and an 'exp' for the probabilities,
+// instead of the evaluation of the base curve, typically a search over its knots;
+// other queries, including all the hazard rates, are forwarded to the base curve.
+// A time 'T' is a whole day if 'T / day' is within a billionth of an integer, where
+// 'day' is the length of a day in the unit of time of the base curve, so that the
+// rounding errors of computing 'T' as a number of days times, or divided by, a
+// constant are tolerated.
+// The table holds 'horizon + 1' doubles: a 60 years horizon of 21915 days takes
+// about 171 KiB, more than a typical L2 cache, so that the benefit is largest when
+// queries are concentrated on a range of dates, or the base curve is expensive;
+// "bench/day_indexed_survival.cpp" measures the trade-off. The table is computed at
+// construction, with one batched call to the base curve.
+// The results at whole days differ from those of the base curve by rounding errors,
+// the survival probabilities being recomputed as 'exp(-H)'.
+class DayIndexedSurvival : public pdg::Survival
+{
+  pdg::Survival const& base_;
+  pdg::Time            day_;
+  double               days_per_unit_;
+  // Cumulative hazard of 'base_' at each whole day, from '0' to the horizon.
+  std::vector<double>  table_;
+
+public:
+  // Default horizon: 60 years of 365.25 days.
+  static constexpr std::size_t default_horizon = 21915;
+
+  // Create a curve decorating the specified 'base' with a lookup table of its
+  // cumulative hazard at every whole day until the specified 'horizon', in days,
+  // where a day lasts the specified 'day' in the unit of time of 'base', e.g.
+  // '1.0 / 365' for years. A 'pdg::computation_error' is thrown if the computation
+  // of the table fails. The behaviour is undefined unless '0 < day', and 'base'
+  // outlives this object.
+  DayIndexedSurvival(pdg::Survival const& base, pdg::Time const& day,
+                     std::size_t horizon = default_horizon);
+
+  // Return the horizon of the lookup table, in days.
+  std::size_t horizon() const noexcept;
+
+  // Return the cumulative hazard at the specified 'day', by a lookup in the table.
+  // The behaviour is undefined unless 'day <= horizon()'.
+  double cumulative_hazard_at_day(std::size_t day) const noexcept;
+
+  // Return the survival probability at the specified 'day', computed from the
+  // lookup table. The behaviour is undefined unless 'day <= horizon()'.
+  pdg::Probability survival_prob_at_day(std::size_t day) const noexcept;
+
+private:
+  // Load into the specified 'day' the index of the whole day of the specified 'T',
+  // and return 'true', if 'T' is a whole day within the horizon; return 'false'
+  // otherwise.
+  bool find_day(pdg::Time const& T, std::size_t& day) const noexcept;
+
+  pdg::Probability survival_prob_impl(pdg::Time const& T) const override;
+  double hazard_rate_impl(pdg::Time const& T) const override;
+  pdg::Probability conditional_survival_prob_impl(
+                          pdg::Time const& T, pdg::Time const& t) const override;
+  double cumulative_hazard_impl(pdg::Time const& T) const override;
+  void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                    double* result) const override;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <cassert>
+#include <cmath> // exp, abs, isinf, isnan, nearbyint
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+PDG_INLINE pdg::DayIndexedSurvival::DayIndexedSurvival(pdg::Survival const& base,
+                                                       pdg::Time const& day,
+                                                       std::size_t horizon)
+: base_(base)
+, day_(day)
+, days_per_unit_(1 / day)
+, table_(horizon + 1)
+{
+  assert( 0 < day );
+  std::vector<pdg::Time> days(horizon + 1);
+  for (std::size_t i = 0; i != days.size(); ++i) days[i] = i * day_;
+  base_.cumulative_hazard(days.data(), days.size(), table_.data());
+}
+
+PDG_INLINE std::size_t pdg::DayIndexedSurvival::horizon() const noexcept
+{
+  return table_.size() - 1;
+}
+
+PDG_INLINE double pdg::DayIndexedSurvival::cumulative_hazard_at_day(
+                                                    std::size_t day) const noexcept
+{
+  assert( day <= horizon() );
+  return table_[day];
+}
+
+PDG_INLINE pdg::Probability pdg::DayIndexedSurvival::survival_prob_at_day(
+                                                    std::size_t day) const noexcept
+{
+  assert( day <= horizon() );
+  return std::exp(- table_[day]);
+}
+
+PDG_INLINE bool pdg::DayIndexedSurvival::find_day(pdg::Time const& T,
+                                                  std::size_t& day) const noexcept
+{
+  assert( !std::isnan(T) );
+  auto const days = T * days_per_unit_;
+  auto const whole = std::nearbyint(days);
+  // Written so that 'NaN' is not a whole day: converting it would be undefined.
+  if (!(std::abs(days - whole) <= 1e-9 && whole <= horizon())) return false;
+  day = static_cast<std::size_t>(whole);
+  return true;
+}
+
+PDG_INLINE pdg::Probability pdg::DayIndexedSurvival::survival_prob_impl(
+                                                          pdg::Time const& T) const
+{
+  std::size_t day;
+  if (find_day(T, day)) return std::exp(- table_[day]);
+  return base_.survival_prob(T);
+}
+
+PDG_INLINE double pdg::DayIndexedSurvival::hazard_rate_impl(pdg::Time const& T) const
+{
+  return base_.hazard_rate(T);
+}
+
+PDG_INLINE pdg::Probability pdg::DayIndexedSurvival::conditional_survival_prob_impl(
+                                     pdg::Time const& T, pdg::Time const& t) const
+{
+  std::size_t day_T, day_t;
+  if (find_day(T, day_T) && find_day(t, day_t)) {
+    if (std::isinf(table_[day_t])) throw computation_error{};
+    return std::exp(table_[day_t] - table_[day_T]);
+  }
+  return base_.conditional_survival_prob(T, t);
+}
+
+PDG_INLINE double pdg::DayIndexedSurvival::cumulative_hazard_impl(
+                                                          pdg::Time const& T) const
+{
+  std::size_t day;
+  if (find_day(T, day)) return table_[day];
+  return base_.cumulative_hazard(T);
+}
+
+PDG_INLINE void pdg::DayIndexedSurvival::cumulative_hazard_batch_impl(
+                  pdg::Time const* T, std::size_t count, double* result) const
+{
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( T[i] >= 0 );
+    result[i] = cumulative_hazard_impl(T[i]);
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // DAY_INDEXED_SURVIVAL_HPP_INCLUDE_GUARD
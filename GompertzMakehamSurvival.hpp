@@ -0,0 +1,209 @@
+#ifndef GOMPERTZ_MAKEHAM_SURVIVAL_HPP_INCLUDE_GUARD
+#define GOMPERTZ_MAKEHAM_SURVIVAL_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+
+#include "config.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class implements the 'pdg::Survival' protocol with the Gompertz–Makeham law of
+// mortality: the hazard rate 'h(T) = lambda + alpha exp(beta T)' is the sum of an
+// age-independent term 'lambda' and of an exponentially increasing one, so that
+// 'H(T) = lambda T + (alpha / beta) (exp(beta T) - 1)'. The survival probability,
+// hazard rate and cumulative hazard are computed in closed form; the inverse of the
+// survival probability is computed in closed form in terms of the Lambert W function,
+// evaluated by Halley's iteration.
+class GompertzMakehamSurvival : public pdg::Survival
+{
+  double makeham_; // lambda
+  double alpha_;
+  double beta_;
+
+public:
+  // Create a Gompertz–Makeham curve of the specified 'makeham' term 'lambda', and
+  // Gompertz 'alpha' and 'beta' terms. The behaviour is undefined unless
+  // '0 <= makeham', '0 < alpha' and '0 < beta'.
+  GompertzMakehamSurvival(double makeham, double alpha, double beta);
+
+  // Return the Makeham term 'lambda' of this curve.
+  double makeham() const noexcept;
+  // Return the Gompertz terms 'alpha' and 'beta' of this curve.
+  double alpha() const noexcept;
+  double beta() const noexcept;
+
+  // Return the time 'T' such that 'survival_prob(T) == u' for the specified 'u', so
+  // that failure times are sampled from uniform variates 'u'. '+infty' is returned if
+  // 'u == 0'. The behaviour is undefined unless '0 <= u <= 1'.
+  pdg::Time inverse_survival_prob(pdg::Probability u) const noexcept;
+
+  // Load the inverses of the survival probability at the specified 'count' values
+  // starting at the specified 'u' into the array starting at the specified 'result'.
+  // The behaviour is undefined unless the values are in '[0, 1]'.
+  void inverse_survival_prob(pdg::Probability const* u, std::size_t count,
+                             pdg::Time* result) const noexcept;
+
+private:
+  pdg::Probability survival_prob_impl(pdg::Time const& T) const override;
+  double hazard_rate_impl(pdg::Time const& T) const override;
+  pdg::Probability conditional_survival_prob_impl(
+                          pdg::Time const& T, pdg::Time const& t) const override;
+  double cumulative_hazard_impl(pdg::Time const& T) const override;
+  void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                    double* result) const override;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // max
+#include <cassert>
+#include <cmath>     // abs, exp, expm1, isinf, log, log1p
+#include <limits>
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+namespace pdg::detail {
+
+// Return 'W(exp(L))' for the specified 'L', where 'W' is the principal branch of the
+// Lambert W function, i.e. the solution 'w > 0' of 'w + log(w) == L'. Working with
+// the logarithm of the argument avoids its overflow for large 'L'. Halley's
+// iteration converges cubically from the initial guess, in a few steps.
+PDG_INLINE double lambert_w_exp(double L) noexcept
+{
+  if (std::isinf(L)) return L > 0 ? L : 0;
+  // 'W(x) ~ log(1 + x)' for small 'x', and 'W(exp(L)) ~ L - log(L)' for large 'L'.
+  double w = L < 2 ? std::log1p(std::exp(L)) : L - std::log(L);
+  for (int i = 0; i != 32; ++i) {
+    // f(w) = w + log(w) - L, f'(w) = 1 + 1/w, f''(w) = -1/w^2.
+    auto const f   = w + std::log(w) - L;
+    auto const df  = 1 + 1 / w;
+    auto const d2f = -1 / (w * w);
+    auto const step = 2 * f * df / (2 * df * df - f * d2f);
+    auto next = w - step;
+    if (next <= 0) next = w / 2; // stay in the domain of 'log'
+    if (std::abs(next - w) <= 4 * std::numeric_limits<double>::epsilon() * next) {
+      return next;
+    }
+    w = next;
+  }
+  return w;
+}
+
+} // namespace pdg::detail
+
+PDG_INLINE pdg::GompertzMakehamSurvival::GompertzMakehamSurvival(double makeham,
+                                                                 double alpha,
+                                                                 double beta)
+: makeham_(makeham)
+, alpha_(alpha)
+, beta_(beta)
+{
+  assert( 0 <= makeham );
+  assert( 0 < alpha );
+  assert( 0 < beta );
+}
+
+PDG_INLINE double pdg::GompertzMakehamSurvival::makeham() const noexcept
+{
+  return makeham_;
+}
+
+PDG_INLINE double pdg::GompertzMakehamSurvival::alpha() const noexcept
+{
+  return alpha_;
+}
+
+PDG_INLINE double pdg::GompertzMakehamSurvival::beta() const noexcept
+{
+  return beta_;
+}
+
+PDG_INLINE pdg::Time pdg::GompertzMakehamSurvival::inverse_survival_prob(
+                                                   pdg::Probability u) const noexcept
+{
+  assert( 0 <= u && u <= 1 );
+  // Solve 'H(T) == y'. Without Makeham term, 'T = log(1 + beta y / alpha) / beta'.
+  // Otherwise, 'z = beta T' solves 'z + a exp(z) == c', with 'a = alpha / lambda' and
+  // 'c = (beta y + alpha) / lambda', hence 'z = c - w' with 'w = W(a exp(c))'. As
+  // 'log(w) + w == log(a) + c', 'z = log(w) - log(a)', which avoids subtracting the
+  // close large values 'c' and 'w'.
+  auto const y = - std::log(u);
+  if (makeham_ == 0) return std::log1p(beta_ * y / alpha_) / beta_;
+  if (std::isinf(y)) return y;
+  auto const a = alpha_ / makeham_;
+  auto const c = (beta_ * y + alpha_) / makeham_;
+  auto const log_a = std::log(a);
+  auto const w = pdg::detail::lambert_w_exp(log_a + c);
+  auto z = std::log(w) - log_a;
+  if (z < 1) {
+    // As 'u' tends to '1', 'z' tends to '0' and 'log(w) - log(a)' cancels in turn.
+    // Refine 'z' by Newton's iteration on 'f(z) = z + a expm1(z) - r', with
+    // 'r = c - a = beta y / lambda', whose terms are computed without cancellation;
+    // 'z ~ r / (1 + a)' is the starting point if 'z' is not positive.
+    auto const r = beta_ * y / makeham_;
+    if (!(0 < z)) z = r / (1 + a);
+    for (int i = 0; i != 8; ++i) {
+      auto const step = (z + a * std::expm1(z) - r) / (1 + a * std::exp(z));
+      z -= step;
+      if (std::abs(step) <= 4 * std::numeric_limits<double>::epsilon() * z) break;
+    }
+  }
+  // Rounding errors could make the result slightly negative for 'u' close to '1'.
+  return std::max(0.0, z / beta_);
+}
+
+PDG_INLINE void pdg::GompertzMakehamSurvival::inverse_survival_prob(
+                pdg::Probability const* u, std::size_t count, pdg::Time* result) const noexcept
+{
+  for (std::size_t i = 0; i != count; ++i) {
+    result[i] = inverse_survival_prob(u[i]);
+  }
+}
+
+PDG_INLINE pdg::Probability pdg::GompertzMakehamSurvival::survival_prob_impl(
+                                                          pdg::Time const& T) const
+{
+  return std::exp(- cumulative_hazard_impl(T));
+}
+
+PDG_INLINE double pdg::GompertzMakehamSurvival::hazard_rate_impl(
+                                                          pdg::Time const& T) const
+{
+  return makeham_ + alpha_ * std::exp(beta_ * T);
+}
+
+PDG_INLINE pdg::Probability pdg::GompertzMakehamSurvival::conditional_survival_prob_impl(
+                                     pdg::Time const& T, pdg::Time const& t) const
+{
+  // 'H(T) - H(t) = lambda (T - t) + (alpha / beta) exp(beta t) (exp(beta (T - t)) - 1)',
+  // without cancellation.
+  auto const dt = T - t;
+  return std::exp(- (makeham_ * dt
+                     + alpha_ / beta_ * std::exp(beta_ * t) * std::expm1(beta_ * dt)));
+}
+
+PDG_INLINE double pdg::GompertzMakehamSurvival::cumulative_hazard_impl(
+                                                          pdg::Time const& T) const
+{
+  return makeham_ * T + alpha_ / beta_ * std::expm1(beta_ * T);
+}
+
+PDG_INLINE void pdg::GompertzMakehamSurvival::cumulative_hazard_batch_impl(
+                  pdg::Time const* T, std::size_t count, double* result) const
+{
+  // Without virtual calls nor branches, the loop can be vectorized by compilers
+  // having vector versions of the mathematical functions.
+  auto const makeham = makeham_, ratio = alpha_ / beta_, beta = beta_;
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( T[i] >= 0 );
+    result[i] = makeham * T[i] + ratio * std::expm1(beta * T[i]);
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // GOMPERTZ_MAKEHAM_SURVIVAL_HPP_INCLUDE_GUARD
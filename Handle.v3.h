@@ -4,6 +4,8 @@
 
 #include <type_traits> // aligned_storage
 
+#include "is_trivially_relocatable.hpp"
+
 namespace lib {
 
 template<typename Body, std::size_t Size = 4 * sizeof(void*)>
@@ -41,4 +43,14 @@ public:
 
 } // namespace lib
 
+// Note that 'ttl::is_trivially_relocatable' is specialized for 'lib::Handle'
+// in "HandleImpl.h" only: whether the body is stored in-place depends on its
+// size, which is unknown where it is incomplete. The trait must be queried
+// where the implementation is included, e.g. where 'Body' is defined.
+
+// Declare that 'lib::Handle<Body>' is explicitly instantiated in another
+// translation unit, using 'PDG_INSTANTIATE_HANDLE(Body)' (see "HandleImpl.h"),
+// so that translation units including the implementation do not instantiate it.
+#define PDG_EXTERN_HANDLE(...) extern template class lib::Handle<__VA_ARGS__>
+
 #endif // HANDLE_H_INCLUDE_GUARD
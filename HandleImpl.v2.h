@@ -8,6 +8,8 @@
 
 #include <memory> // unique_ptr
 
+#include "is_trivially_relocatable.hpp"
+
 namespace lib {
 
 template<typename Body>
@@ -43,6 +45,18 @@ public:
 
 } // namespace lib
 
+// A 'Handle' only holds a pointer to its body: it can be relocated by copying
+// its bytes, whatever the body.
+namespace ttl {
+template<typename Body>
+struct is_trivially_relocatable< lib::Handle<Body> > : std::true_type {};
+} // namespace ttl
+
+// Declare that 'lib::Handle<Body>' is explicitly instantiated in another
+// translation unit, using 'PDG_INSTANTIATE_HANDLE(Body)' (see "HandleImpl.h"),
+// so that translation units including the implementation do not instantiate it.
+#define PDG_EXTERN_HANDLE(...) extern template class lib::Handle<__VA_ARGS__>
+
 #endif // HANDLE_H_INCLUDE_GUARD
 ///////////////////////////////////////////////////////////////////////////////
 #include <cassert>
@@ -98,4 +112,8 @@ auto lib::Handle<Body>::operator -> () noexcept
   return handle_.get();
 }
 
+// Explicitly instantiate 'lib::Handle<Body>', typically in the translation
+// unit implementing the class using it; see 'PDG_EXTERN_HANDLE'.
+#define PDG_INSTANTIATE_HANDLE(...) template class lib::Handle<__VA_ARGS__>
+
 #endif // HANDLE_IMPL_H_INCLUDE_GUARD
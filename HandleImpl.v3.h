@@ -9,6 +9,8 @@
 
 #include <type_traits> // aligned_storage
 
+#include "is_trivially_relocatable.hpp"
+
 namespace lib {
 
 template<typename Body, std::size_t Size = 4 * sizeof(void*)>
@@ -46,6 +48,16 @@ public:
 
 } // namespace lib
 
+// Note that 'ttl::is_trivially_relocatable' is specialized for 'lib::Handle'
+// in "HandleImpl.h" only: whether the body is stored in-place depends on its
+// size, which is unknown where it is incomplete. The trait must be queried
+// where the implementation is included, e.g. where 'Body' is defined.
+
+// Declare that 'lib::Handle<Body>' is explicitly instantiated in another
+// translation unit, using 'PDG_INSTANTIATE_HANDLE(Body)' (see "HandleImpl.h"),
+// so that translation units including the implementation do not instantiate it.
+#define PDG_EXTERN_HANDLE(...) extern template class lib::Handle<__VA_ARGS__>
+
 #endif // HANDLE_H_INCLUDE_GUARD
 ///////////////////////////////////////////////////////////////////////////////
 #include <cassert>
@@ -53,11 +65,12 @@ public:
 #include <new>      // launder
 #include <utility>  // move
 
-namespace {
+namespace lib::detail {
 
+// Whether a 'Body' can be stored in-place in 'Size' bytes.
 template<class Body, std::size_t Size>
-bool constexpr fits  = sizeof(Body) <= Size
-                    && alignof(Body) <= alignof(std::aligned_storage_t<Size>);
+inline bool constexpr fits  = sizeof(Body) <= Size
+                           && alignof(Body) <= alignof(std::aligned_storage_t<Size>);
 
 // Syntactic sugar that returns a reference to a 'Body' from a 'Handle'.
 template<class Body, std::size_t Size>
@@ -73,17 +86,24 @@ auto body(lib::Handle<Body, Size>& handle) noexcept
   return *(handle.operator->());
 }
 
-} // unnamed namespace
+} // namespace lib::detail
+
+// A 'Handle' can be relocated by copying its bytes if its body is allocated
+// dynamically, or if its in-place body can.
+template<class Body, std::size_t Size>
+struct ttl::is_trivially_relocatable< lib::Handle<Body, Size> >
+: std::disjunction < std::bool_constant< !lib::detail::fits<Body, Size> >
+                   , ttl::is_trivially_relocatable<Body> > {};
 
 template<class Body, std::size_t Size>
 lib::Handle<Body, Size>::Handle()
 {
-  if constexpr (::fits<Body, Size>) { // allocate in-place
+  if constexpr (lib::detail::fits<Body, Size>) { // allocate in-place
     ::new (&storage_) Body();
   }
   else { // allocate dynamically
     using BodyPtr = std::unique_ptr<Body>;
-    static_assert( ::fits<BodyPtr, Size>, "storage cannot hold a pointer");
+    static_assert( lib::detail::fits<BodyPtr, Size>, "storage cannot hold a pointer");
     ::new (&storage_) BodyPtr(std::make_unique<Body>());
   }
 }
@@ -92,16 +112,16 @@ lib::Handle<Body, Size>::Handle()
 template<class Body, std::size_t Size>
 lib::Handle<Body, Size>::Handle(Handle const& other)
 {
-  if constexpr (::fits<Body, Size>) { // allocate in-place
-    ::new (&storage_) Body(::body(other));
+  if constexpr (lib::detail::fits<Body, Size>) { // allocate in-place
+    ::new (&storage_) Body(lib::detail::body(other));
   }
   else { // allocate dynamically
     using BodyPtr = std::unique_ptr<Body>;
-    static_assert( ::fits<BodyPtr, Size>, "storage cannot hold a pointer");
+    static_assert( lib::detail::fits<BodyPtr, Size>, "storage cannot hold a pointer");
     // Correctly copy moved-from handles...
     auto const& src_p = *std::launder(reinterpret_cast<BodyPtr const*>(&other.storage_));
     if (src_p != nullptr) { // clone
-      ::new (&storage_) BodyPtr(std::make_unique<Body>(::body(other)));
+      ::new (&storage_) BodyPtr(std::make_unique<Body>(lib::detail::body(other)));
     } 
     else { // construct null unique_ptr, i.e. moved-from large body.
       ::new (&storage_) BodyPtr(nullptr);
@@ -112,12 +132,12 @@ lib::Handle<Body, Size>::Handle(Handle const& other)
 template<class Body, std::size_t Size>
 lib::Handle<Body, Size>::Handle(Handle&& other) noexcept
 {
-  if constexpr (::fits<Body, Size>) { // move-construct in-place
-    ::new (&storage_) Body(std::move(::body(other)));
+  if constexpr (lib::detail::fits<Body, Size>) { // move-construct in-place
+    ::new (&storage_) Body(std::move(lib::detail::body(other)));
   }
   else { // move unique_ptr
     using BodyPtr = std::unique_ptr<Body>;
-    static_assert( ::fits<BodyPtr, Size>, "storage cannot hold a pointer");
+    static_assert( lib::detail::fits<BodyPtr, Size>, "storage cannot hold a pointer");
     auto& src_p = *std::launder(reinterpret_cast<BodyPtr*>(&other.storage_));
     ::new (&storage_) BodyPtr(std::move(src_p));
   }
@@ -126,8 +146,8 @@ lib::Handle<Body, Size>::Handle(Handle&& other) noexcept
 template<class Body, std::size_t Size>
 lib::Handle<Body, Size>::~Handle() noexcept
 {
-  if constexpr (::fits<Body, Size>) { // destroy body
-    ::body(*this).~body_type();
+  if constexpr (lib::detail::fits<Body, Size>) { // destroy body
+    lib::detail::body(*this).~body_type();
   }
   else { // destroy unique_ptr
     using BodyPtr = std::unique_ptr<Body>;
@@ -149,12 +169,12 @@ template<class Body, std::size_t Size>
 auto lib::Handle<Body, Size>::operator = (Handle && other) noexcept
 -> Handle&
 {
-  if constexpr (::fits<Body, Size>) { // move-assign in-place
-    ::body(*this) = std::move(::body(other));
+  if constexpr (lib::detail::fits<Body, Size>) { // move-assign in-place
+    lib::detail::body(*this) = std::move(lib::detail::body(other));
   }
   else { // move-assign unique_ptr
     using BodyPtr = std::unique_ptr<Body>;
-    static_assert( ::fits<BodyPtr, Size>, "storage cannot hold a pointer");
+    static_assert( lib::detail::fits<BodyPtr, Size>, "storage cannot hold a pointer");
     auto& src_p = *std::launder(reinterpret_cast<BodyPtr*>(&other.storage_));
     auto& dst_p = *std::launder(reinterpret_cast<BodyPtr*>(&storage_));
     dst_p = std::move(src_p);
@@ -166,7 +186,7 @@ template<class Body, std::size_t Size>
 auto lib::Handle<Body, Size>::operator -> () const noexcept
 -> body_type const*
 {
-  if constexpr (::fits<Body, Size>) { // allocated in-place
+  if constexpr (lib::detail::fits<Body, Size>) { // allocated in-place
     return std::launder(reinterpret_cast<body_type const*>(&storage_));
   }
   else { // allocated dynamically
@@ -185,4 +205,8 @@ auto lib::Handle<Body, Size>::operator -> () noexcept
   return const_cast<body_type*>(const_ptr);
 }
 
+// Explicitly instantiate 'lib::Handle<Body>', typically in the translation
+// unit implementing the class using it; see 'PDG_EXTERN_HANDLE'.
+#define PDG_INSTANTIATE_HANDLE(...) template class lib::Handle<__VA_ARGS__>
+
 #endif // HANDLE_IMPL_H_INCLUDE_GUARD
@@ -0,0 +1,157 @@
+#ifndef LOG_LOGISTIC_SURVIVAL_HPP_INCLUDE_GUARD
+#define LOG_LOGISTIC_SURVIVAL_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+
+#include "config.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class implements the 'pdg::Survival' protocol with the log-logistic law of
+// shape 'beta' and scale 'alpha': 'S(T) = 1 / (1 + (T / alpha)^beta)', so that
+// 'H(T) = log(1 + (T / alpha)^beta)' and
+// 'h(T) = (beta / alpha) (T / alpha)^(beta-1) / (1 + (T / alpha)^beta)'. The hazard
+// rate is decreasing if 'beta <= 1', and increases then decreases if 'beta > 1'; if
+// 'beta < 1', it is '+infty' at '0'. All the functions, including the inverse of the
+// survival probability, are computed in closed form.
+class LogLogisticSurvival : public pdg::Survival
+{
+  double shape_;
+  double scale_;
+
+public:
+  // Create a log-logistic curve of the specified 'shape' and 'scale'. The behaviour
+  // is undefined unless '0 < shape' and '0 < scale'.
+  LogLogisticSurvival(double shape, double scale);
+
+  // Return the shape 'beta' of this curve.
+  double shape() const noexcept;
+  // Return the scale 'alpha' of this curve, its median.
+  double scale() const noexcept;
+
+  // Return the time 'T' such that 'survival_prob(T) == u' for the specified 'u', so
+  // that failure times are sampled from uniform variates 'u'. '+infty' is returned if
+  // 'u == 0'. The behaviour is undefined unless '0 <= u <= 1'.
+  pdg::Time inverse_survival_prob(pdg::Probability u) const noexcept;
+
+  // Load the inverses of the survival probability at the specified 'count' values
+  // starting at the specified 'u' into the array starting at the specified 'result'.
+  // The behaviour is undefined unless the values are in '[0, 1]'.
+  void inverse_survival_prob(pdg::Probability const* u, std::size_t count,
+                             pdg::Time* result) const noexcept;
+
+private:
+  pdg::Probability survival_prob_impl(pdg::Time const& T) const override;
+  double hazard_rate_impl(pdg::Time const& T) const override;
+  pdg::Probability conditional_survival_prob_impl(
+                          pdg::Time const& T, pdg::Time const& t) const override;
+  double cumulative_hazard_impl(pdg::Time const& T) const override;
+  void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                    double* result) const override;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <cassert>
+#include <cmath> // exp, log, log1p, pow
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+namespace pdg::detail {
+
+// Return 'log(1 + x^beta)' for the specified 'x' and 'beta', without overflow when
+// 'x^beta' is not representable: if '1 < x', it is computed as
+// 'beta log(x) + log(1 + x^-beta)'. The selections have no side effects, so that
+// compilers can turn them into conditional moves. The behaviour is undefined unless
+// '0 <= x' and '0 < beta'.
+PDG_INLINE double log1p_pow(double x, double beta) noexcept
+{
+  auto const large = 1 < x;
+  auto const tail = std::log1p(std::pow(x, large ? -beta : beta));
+  return large ? beta * std::log(x) + tail : tail;
+}
+
+} // namespace pdg::detail
+
+PDG_INLINE pdg::LogLogisticSurvival::LogLogisticSurvival(double shape, double scale)
+: shape_(shape)
+, scale_(scale)
+{
+  assert( 0 < shape );
+  assert( 0 < scale );
+}
+
+PDG_INLINE double pdg::LogLogisticSurvival::shape() const noexcept
+{
+  return shape_;
+}
+
+PDG_INLINE double pdg::LogLogisticSurvival::scale() const noexcept
+{
+  return scale_;
+}
+
+PDG_INLINE pdg::Time pdg::LogLogisticSurvival::inverse_survival_prob(
+                                                   pdg::Probability u) const noexcept
+{
+  assert( 0 <= u && u <= 1 );
+  return scale_ * std::pow((1 - u) / u, 1 / shape_);
+}
+
+PDG_INLINE void pdg::LogLogisticSurvival::inverse_survival_prob(
+                pdg::Probability const* u, std::size_t count, pdg::Time* result) const noexcept
+{
+  auto const scale = scale_, exponent = 1 / shape_;
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( 0 <= u[i] && u[i] <= 1 );
+    result[i] = scale * std::pow((1 - u[i]) / u[i], exponent);
+  }
+}
+
+PDG_INLINE pdg::Probability pdg::LogLogisticSurvival::survival_prob_impl(
+                                                          pdg::Time const& T) const
+{
+  return 1 / (1 + std::pow(T / scale_, shape_));
+}
+
+PDG_INLINE double pdg::LogLogisticSurvival::hazard_rate_impl(pdg::Time const& T) const
+{
+  // If '1 < x', the numerator and denominator are divided by 'x^beta', which may
+  // overflow.
+  auto const x = T / scale_;
+  if (1 < x) return shape_ / scale_ / (x * (1 + std::pow(x, -shape_)));
+  return shape_ / scale_ * std::pow(x, shape_ - 1) / (1 + std::pow(x, shape_));
+}
+
+PDG_INLINE pdg::Probability pdg::LogLogisticSurvival::conditional_survival_prob_impl(
+                                     pdg::Time const& T, pdg::Time const& t) const
+{
+  return std::exp(pdg::detail::log1p_pow(t / scale_, shape_)
+                - pdg::detail::log1p_pow(T / scale_, shape_));
+}
+
+PDG_INLINE double pdg::LogLogisticSurvival::cumulative_hazard_impl(
+                                                          pdg::Time const& T) const
+{
+  return pdg::detail::log1p_pow(T / scale_, shape_);
+}
+
+PDG_INLINE void pdg::LogLogisticSurvival::cumulative_hazard_batch_impl(
+                  pdg::Time const* T, std::size_t count, double* result) const
+{
+  // Without virtual calls nor branches, the loop can be vectorized by compilers
+  // having vector versions of the mathematical functions.
+  auto const scale = scale_, shape = shape_;
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( T[i] >= 0 );
+    result[i] = pdg::detail::log1p_pow(T[i] / scale, shape);
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // LOG_LOGISTIC_SURVIVAL_HPP_INCLUDE_GUARD
@@ -0,0 +1,271 @@
+#ifndef MAPPED_FILE_SINK_HPP_INCLUDE_GUARD
+#define MAPPED_FILE_SINK_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+#include <string_view>
+#include <sys/types.h> // off_t
+#include <fmt/core.h>
+
+namespace lib {
+
+// This class provides an output sink writing to a file through a memory
+// mapping, meant for very large print jobs. The file is preallocated and
+// mapped in large windows: formatters write directly into the mapped memory,
+// and a new window is mapped only when the current one is exhausted, so that
+// no intermediate buffer is needed and no system call is issued per write.
+// When the sink is closed the file is truncated to the number of bytes written.
+// Failures of the underlying system calls are reported by throwing
+// 'std::system_error'. This class is only available on POSIX systems.
+class MappedFileSink
+{
+  int         fd_;           // descriptor of the output file, or '-1'.
+  char*       window_;       // mapped memory, or 'nullptr'.
+  std::size_t window_size_;  // size of the mapped memory.
+  off_t       window_begin_; // file offset of the mapped memory.
+  off_t       file_size_;    // size of the file, including preallocation.
+  off_t       size_;         // number of bytes written.
+  std::size_t granularity_;  // minimum size of a window.
+
+public:
+  // Default minimum size of the windows mapped in memory.
+  static constexpr std::size_t DefaultWindowSize = std::size_t{64} << 20;
+
+  // Create a sink writing to the file at the specified 'path', which is
+  // created or truncated, mapping it in windows of at least the specified
+  // 'window_size' bytes.
+  explicit MappedFileSink(char const* path,
+                          std::size_t window_size = DefaultWindowSize);
+
+  // Close this sink, ignoring errors; see 'close'.
+  ~MappedFileSink() noexcept;
+
+  MappedFileSink(MappedFileSink const&) = delete;
+  MappedFileSink& operator = (MappedFileSink const&) = delete;
+
+  // Return a pointer to at least the specified 'n' writable bytes, located
+  // right after the bytes written so far. The bytes are not written until
+  // 'commit' is called, and the pointer is invalidated by any other call to
+  // a non-const member function.
+  char* reserve(std::size_t n);
+
+  // Mark the first specified 'n' bytes returned by the last call to 'reserve'
+  // as written. The behaviour is undefined unless 'n' is not greater than the
+  // size requested by that call.
+  void commit(std::size_t n) noexcept;
+
+  // Write the specified 'text'.
+  void write(std::string_view text);
+
+  // Write the specified 'args' formatted according to the specified 'format',
+  // as if by 'fmt::print', directly into the mapped memory.
+  template<class... Args>
+  void print(fmt::format_string<Args...> format, Args&&... args);
+
+  // Return the number of bytes written so far.
+  std::size_t size() const noexcept;
+
+  // Unmap the memory, truncate the file to the number of bytes written and
+  // close it. Calling 'close' on a closed sink has no effect.
+  void close();
+
+private:
+  // Map a new window having room for at least the specified 'n' bytes after
+  // the bytes written so far, growing the file as needed.
+  void remap(std::size_t n);
+  // Unmap the current window, if any.
+  void unmap() noexcept;
+};
+
+} // namespace lib
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // max
+#include <cassert>
+#include <cerrno>
+#include <cstring>   // memcpy
+#include <iterator>  // output_iterator_tag
+#include <utility>   // forward
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fmt/format.h> // memory_buffer
+
+namespace lib::detail {
+
+// Throw a 'std::system_error' having the specified 'error' code and 'what'.
+[[noreturn]] inline void throw_system_error(int error, char const* what) {
+  throw std::system_error(error, std::generic_category(), what);
+}
+
+// Output iterator writing characters to the memory in '[next, end)' and, once
+// it is full, appending them to an overflow buffer.
+class spill_iterator
+{
+  char*               next_;
+  char*               end_;
+  fmt::memory_buffer* overflow_;
+
+public:
+  using iterator_category = std::output_iterator_tag;
+  using value_type        = void;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = void;
+
+  // Create an iterator writing to the memory in '[next, end)' and then to
+  // the specified 'overflow'.
+  spill_iterator(char* next, char* end, fmt::memory_buffer& overflow) noexcept
+  : next_(next), end_(end), overflow_(&overflow)
+  { }
+
+  spill_iterator& operator * () noexcept { return *this; }
+  spill_iterator& operator ++ () noexcept { return *this; }
+  spill_iterator& operator ++ (int) noexcept { return *this; }
+
+  spill_iterator& operator = (char c) {
+    if (next_ != end_) {
+      *next_++ = c;
+    }
+    else {
+      overflow_->push_back(c);
+    }
+    return *this;
+  }
+
+  // Return the position following the last character written to memory.
+  char* next() const noexcept { return next_; }
+};
+
+} // namespace lib::detail
+
+inline lib::MappedFileSink::MappedFileSink(char const* path,
+                                           std::size_t window_size)
+: fd_{::open(path, O_RDWR | O_CREAT | O_TRUNC, 0666)}
+, window_{nullptr}
+, window_size_{0}
+, window_begin_{0}
+, file_size_{0}
+, size_{0}
+, granularity_{0}
+{
+  if (fd_ == -1) lib::detail::throw_system_error(errno, "open");
+  auto const page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  // Windows are a whole number of pages, as required by 'mmap' offsets.
+  granularity_ = (std::max(window_size, page_size) + page_size - 1)
+               / page_size * page_size;
+}
+
+inline lib::MappedFileSink::~MappedFileSink() noexcept
+{
+  try {
+    close();
+  }
+  catch (...) {
+    // Intentionally ignored: call 'close' to observe errors.
+  }
+}
+
+inline char* lib::MappedFileSink::reserve(std::size_t n)
+{
+  assert( fd_ != -1 );
+  if (window_ == nullptr
+   || static_cast<std::size_t>(size_ - window_begin_) + n > window_size_) {
+    remap(n);
+  }
+  return window_ + (size_ - window_begin_);
+}
+
+inline void lib::MappedFileSink::commit(std::size_t n) noexcept
+{
+  assert( static_cast<std::size_t>(size_ - window_begin_) + n <= window_size_ );
+  size_ += static_cast<off_t>(n);
+}
+
+inline void lib::MappedFileSink::write(std::string_view text)
+{
+  std::memcpy(reserve(text.size()), text.data(), text.size());
+  commit(text.size());
+}
+
+template<class... Args>
+void lib::MappedFileSink::print(fmt::format_string<Args...> format,
+                                Args&&... args)
+{
+  // Format in place into what is left of the current window, keeping the
+  // output that does not fit aside, so that the arguments are formatted once.
+  auto const first = reserve(0);
+  auto const available = window_size_
+                       - static_cast<std::size_t>(size_ - window_begin_);
+  fmt::memory_buffer overflow;
+  auto const last = fmt::format_to(
+                        lib::detail::spill_iterator(first, first + available, overflow),
+                        format, std::forward<Args>(args)...).next();
+  auto const written = static_cast<std::size_t>(last - first);
+  if (overflow.size() == 0) {
+    commit(written);
+    return;
+  }
+  // The window is full: the new one, mapped from the page holding the next
+  // byte to be written, already holds the bytes written to the file so far.
+  auto const size = written + overflow.size();
+  std::memcpy(reserve(size) + written, overflow.data(), overflow.size());
+  commit(size);
+}
+
+inline std::size_t lib::MappedFileSink::size() const noexcept
+{
+  return static_cast<std::size_t>(size_);
+}
+
+inline void lib::MappedFileSink::close()
+{
+  if (fd_ == -1) return;
+  unmap();
+  auto const fd = fd_;
+  fd_ = -1;
+  if (::ftruncate(fd, size_) != 0) {
+    auto const error = errno;
+    ::close(fd);
+    lib::detail::throw_system_error(error, "ftruncate");
+  }
+  if (::close(fd) != 0) lib::detail::throw_system_error(errno, "close");
+}
+
+inline void lib::MappedFileSink::remap(std::size_t n)
+{
+  unmap();
+  // Map from the page containing the next byte to be written.
+  auto const page_size = static_cast<off_t>(::sysconf(_SC_PAGESIZE));
+  auto const begin = size_ / page_size * page_size;
+  auto const needed = static_cast<std::size_t>(size_ - begin) + n;
+  auto const length = std::max(granularity_,
+                               (needed + granularity_ - 1) / granularity_ * granularity_);
+  auto const end = begin + static_cast<off_t>(length);
+  if (end > file_size_) { // preallocate, so that stores cannot fail
+    if (auto const error = ::posix_fallocate(fd_, file_size_, end - file_size_)) {
+      lib::detail::throw_system_error(error, "posix_fallocate");
+    }
+    file_size_ = end;
+  }
+  auto const memory = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd_, begin);
+  if (memory == MAP_FAILED) lib::detail::throw_system_error(errno, "mmap");
+  ::madvise(memory, length, MADV_SEQUENTIAL);
+  window_       = static_cast<char*>(memory);
+  window_size_  = length;
+  window_begin_ = begin;
+}
+
+inline void lib::MappedFileSink::unmap() noexcept
+{
+  if (window_ != nullptr) {
+    ::munmap(window_, window_size_);
+    window_ = nullptr;
+    window_size_ = 0;
+  }
+}
+
+#endif // MAPPED_FILE_SINK_HPP_INCLUDE_GUARD
@@ -0,0 +1,254 @@
+#ifndef MEMOIZING_PRINTABLE_VALUE_ADAPTER_HPP_INCLUDE_GUARD
+#define MEMOIZING_PRINTABLE_VALUE_ADAPTER_HPP_INCLUDE_GUARD
+
+#include <atomic>
+#include <cstddef>
+#include <memory> // shared_ptr
+#include <mutex>  // once_flag
+#include <string>
+
+#include "PrintableValueAdapter.hpp"
+
+namespace lib {
+
+/******************************************************************************
+* class lib::MemoizingPrintableValueAdapter
+******************************************************************************/
+// This class provides an opt-in alternative to 'lib::PrintableValueAdapter',
+// meant for immutable objects printed repeatedly (e.g. labels, identifiers).
+// The output of an object is rendered once, through the customization point
+// 'format_cp', and memoized: printing it again, or printing a clone of it, only
+// copies the rendered bytes to 'stdout'. If 'T' is regular and 'std::hash<T>' is enabled, rendered
+// outputs are additionally shared among all objects having the same value,
+// through a cache holding at most 'cache_capacity()' values and evicting the
+// least recently used one when full. Otherwise, outputs are memoized per object.
+// Note that the serialization contract is inherited from
+// 'lib::PrintableValueAdapter<T>', so that the two are interchangeable in the
+// binary format.
+template <class T>
+class MemoizingPrintableValueAdapter : public lib::PrintableValueAdapter<T>
+{
+  using Rendered = std::shared_ptr<std::string const>;
+
+  mutable std::once_flag    rendered_once_;
+  mutable std::atomic<bool> ready_{false}; // whether 'rendered_' is set.
+  mutable Rendered          rendered_;     // memoized output, or 'nullptr'.
+
+public:
+  // Create an adapter to the 'lib::PrintableValueProtocol' protocol using
+  // the specified 'obj'. Note that 'obj' is not rendered until printed.
+  /*implicit*/ MemoizingPrintableValueAdapter(T obj);
+
+  // Return the maximum number of values whose outputs are shared through the
+  // cache of 'T'.
+  static std::size_t cache_capacity();
+
+  // Set the maximum number of values whose outputs are shared through the
+  // cache of 'T' to the specified 'capacity', evicting the least recently
+  // used values as needed. By default, the capacity is 4096.
+  static void set_cache_capacity(std::size_t capacity);
+
+private:
+  // Create an adapter of the specified 'obj' whose output is the specified
+  // 'rendered'.
+  MemoizingPrintableValueAdapter(T obj, Rendered rendered);
+
+  // Implement the 'lib::PrintableValueProtocol' protocol by copying the
+  // memoized output to 'stdout', rendering it first if needed.
+  void print_impl() const override;
+  // Implement the 'lib::PrintableValueProtocol' protocol by copying the
+  // adapted object, together with its output if it has already been rendered.
+  lib::PrintableValueProtocol::pointer clone_impl() const override;
+
+  // Return the output of the adapted object, either from the cache of 'T'
+  // or by calling 'format_cp'.
+  Rendered render() const;
+
+private: // Customization point for 'lib::MemoizingPrintableValueAdapter'
+  // Clients are free to specialize the following function template for
+  // their types, to match the behaviour of their respective contracts.
+
+  // Return the output of the specified 'obj', as printed to 'stdout' by the
+  // customization point 'print_cp' of 'lib::PrintableValueAdapter<T>', which
+  // must be specialized to match if 'print_cp' is.
+  // Note that unless specialized, the output of 'lib::print(obj)' is returned,
+  // as rendered by 'lib::printer<T>{}(obj, buffer)'; it is a compile-time
+  // error if 'lib::printer<T>' is specialized without that overload.
+  static std::string format_cp(T const& obj);
+};
+
+} // namespace lib
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <cstdio>     // fwrite
+#include <functional> // hash
+#include <list>
+#include <unordered_map>
+#include <utility>    // move
+
+#include "is_printable.hpp"
+
+namespace lib::detail {
+
+template<class T>
+using std_hash_t = decltype(std::hash<T>{}(std::declval<T const&>()));
+
+template<class T>
+using printer_render_t = decltype(lib::printer<T>{}(std::declval<T const&>(),
+                                                    std::declval<std::string&>()));
+
+// Whether the outputs of objects of type 'T' can be shared by value.
+template<class T>
+inline constexpr bool is_memoizable_by_value = ttl::is_regular_v<T>
+                                            && ttl::detail::is_detected_type<std_hash_t, T, std::size_t>::value;
+
+// This class provides a cache of the outputs of values of type 'T', holding
+// at most a given number of values and evicting the least recently used one.
+// It is safe to use concurrently.
+template<class T>
+class PrintCache
+{
+  using Rendered = std::shared_ptr<std::string const>;
+  using Entry    = std::pair<Rendered, typename std::list<T>::iterator>;
+
+  std::mutex                       mutex_;
+  std::size_t                      capacity_ = 4096;
+  std::list<T>                     recency_; // most recently used first.
+  std::unordered_map<T, Entry>     entries_;
+
+public:
+  // Return the cache of type 'T', shared by all translation units.
+  static PrintCache& instance() {
+    static PrintCache cache;
+    return cache;
+  }
+
+  std::size_t capacity() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+
+  void set_capacity(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    evict();
+  }
+
+  // Return the output of the specified 'obj', calling the specified 'render'
+  // only if it is not cached.
+  template<class Render>
+  Rendered find_or_render(T const& obj, Render render) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto const it = entries_.find(obj);
+      if (it != entries_.end()) {
+        recency_.splice(recency_.begin(), recency_, it->second.second);
+        return it->second.first;
+      }
+    }
+    // Render outside of the lock: concurrent misses on the same value
+    // render it more than once, but agree on the result.
+    auto rendered = std::make_shared<std::string const>(render(obj));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ != 0 && entries_.find(obj) == entries_.end()) {
+      recency_.push_front(obj);
+      entries_.emplace(obj, Entry{rendered, recency_.begin()});
+      evict();
+    }
+    return rendered;
+  }
+
+private:
+  // Evict the least recently used values until the capacity is honored.
+  // The behaviour is undefined unless 'mutex_' is locked.
+  void evict() {
+    while (entries_.size() > capacity_) {
+      entries_.erase(recency_.back());
+      recency_.pop_back();
+    }
+  }
+};
+
+} // namespace lib::detail
+
+template<class T>
+lib::MemoizingPrintableValueAdapter<T>::MemoizingPrintableValueAdapter(T obj)
+: lib::PrintableValueAdapter<T>(std::move(obj))
+{ }
+
+template<class T>
+lib::MemoizingPrintableValueAdapter<T>::MemoizingPrintableValueAdapter(
+                                                   T obj, Rendered rendered)
+: lib::PrintableValueAdapter<T>(std::move(obj))
+, ready_(true)
+, rendered_(std::move(rendered))
+{ }
+
+template<class T>
+std::size_t lib::MemoizingPrintableValueAdapter<T>::cache_capacity()
+{
+  if constexpr (lib::detail::is_memoizable_by_value<T>) {
+    return lib::detail::PrintCache<T>::instance().capacity();
+  }
+  else {
+    return 0;
+  }
+}
+
+template<class T>
+void lib::MemoizingPrintableValueAdapter<T>::set_cache_capacity(
+                                                        std::size_t capacity)
+{
+  if constexpr (lib::detail::is_memoizable_by_value<T>) {
+    lib::detail::PrintCache<T>::instance().set_capacity(capacity);
+  }
+}
+
+template<class T>
+void lib::MemoizingPrintableValueAdapter<T>::print_impl() const
+{
+  if (!ready_.load(std::memory_order_acquire)) {
+    std::call_once(rendered_once_, [this] {
+      rendered_ = render();
+      ready_.store(true, std::memory_order_release);
+    });
+  }
+  std::fwrite(rendered_->data(), 1, rendered_->size(), stdout);
+}
+
+template<class T>
+auto lib::MemoizingPrintableValueAdapter<T>::clone_impl() const
+-> lib::PrintableValueProtocol::pointer
+{
+  // 'rendered_' is not modified once 'ready_' is set.
+  if (ready_.load(std::memory_order_acquire)) {
+    return std::unique_ptr<lib::MemoizingPrintableValueAdapter<T>>(
+                  new lib::MemoizingPrintableValueAdapter<T>(this->value(), rendered_));
+  }
+  return std::make_unique<lib::MemoizingPrintableValueAdapter<T>>(this->value());
+}
+
+template<class T>
+auto lib::MemoizingPrintableValueAdapter<T>::render() const -> Rendered
+{
+  if constexpr (lib::detail::is_memoizable_by_value<T>) {
+    return lib::detail::PrintCache<T>::instance().find_or_render(this->value(), &format_cp);
+  }
+  else {
+    return std::make_shared<std::string const>(format_cp(this->value()));
+  }
+}
+
+template<class T>
+std::string lib::MemoizingPrintableValueAdapter<T>::format_cp(T const& obj)
+{
+  static_assert(ttl::detail::is_detected_type<lib::detail::printer_render_t, T, void>::value,
+                "lib::printer<T> cannot render to a string: specialize format_cp");
+  std::string result;
+  lib::printer<T>{}(obj, result);
+  return result;
+}
+
+#endif // MEMOIZING_PRINTABLE_VALUE_ADAPTER_HPP_INCLUDE_GUARD
@@ -0,0 +1,341 @@
+#ifndef PACKED_PRINTABLE_VALUES_HPP_INCLUDE_GUARD
+#define PACKED_PRINTABLE_VALUES_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+#include <iterator>
+#include <memory> // unique_ptr
+#include <vector>
+
+#include "PrintableValueAdapter.hpp"
+
+namespace lib {
+
+/******************************************************************************
+* class lib::PackedPrintableValues
+******************************************************************************/
+// This class provides a heterogeneous sequence of printable values, meant to
+// replace 'std::vector<lib::PrintableValueProtocol::pointer>' for long lists.
+// Instead of allocating each value on its own, 'lib::PrintableValueAdapter<T>'
+// objects are stored back-to-back in a single growable buffer, and each element
+// records its offset in the buffer together with a table of the operations
+// needed to copy, relocate and destroy it. Iterating over, printing and copying
+// all the values therefore traverse memory linearly. Elements are accessed
+// through the 'lib::PrintableValueProtocol' interface; references to them are
+// invalidated when the buffer grows. Value semantics are provided: copying a
+// 'PackedPrintableValues' object clones all its values. Stored types must be
+// nothrow move constructible, and not over-aligned.
+class PackedPrintableValues
+{
+  // Table of the operations on an element of a given type.
+  struct Operations
+  {
+    void (*copy)    (void const* from, void* to);
+    void (*relocate)(void* from, void* to) noexcept;
+    void (*destroy) (void* obj) noexcept;
+  };
+
+  struct Element
+  {
+    std::size_t       offset;      // of the adapter in the buffer.
+    std::size_t       base_offset; // of its 'PrintableValueProtocol' base.
+    Operations const* operations;
+  };
+
+  struct Deallocate { void operator () (std::byte* storage) const noexcept; };
+
+  std::unique_ptr<std::byte[], Deallocate> storage_;
+  std::size_t                              size_;     // bytes in use.
+  std::size_t                              capacity_; // bytes allocated.
+  std::vector<Element>                     elements_;
+
+public:
+  // Iterator over the elements, as 'lib::PrintableValueProtocol' objects.
+  class const_iterator;
+
+  // Create an empty sequence.
+  PackedPrintableValues() noexcept;
+
+  /* Rule of 5 */
+  PackedPrintableValues(PackedPrintableValues const& other);
+  PackedPrintableValues(PackedPrintableValues && other) noexcept;
+
+  ~PackedPrintableValues() noexcept;
+
+  PackedPrintableValues& operator = (PackedPrintableValues const& other);
+  PackedPrintableValues& operator = (PackedPrintableValues && other) noexcept;
+
+  // Append a 'lib::PrintableValueAdapter<T>' adapting the specified 'obj'.
+  template<class T>
+  void push_back(T obj);
+
+  // Destroy all the elements, keeping the buffer for reuse.
+  void clear() noexcept;
+
+  // Ensure that elements occupying up to the specified 'bytes' in total can
+  // be stored without growing the buffer.
+  void reserve(std::size_t bytes);
+
+  // Return the number of elements.
+  std::size_t size() const noexcept;
+  // Return 'true' if there are no elements, and 'false' otherwise.
+  bool empty() const noexcept;
+
+  // Return a reference to the element at the specified 'index'.
+  // The behaviour is undefined unless 'index < size()'.
+  lib::PrintableValueProtocol const& operator [] (std::size_t index) const noexcept;
+
+  const_iterator begin() const noexcept;
+  const_iterator end()   const noexcept;
+
+  // Print all the elements to 'stdout', in order.
+  void print_all() const;
+
+private:
+  // Grow the buffer to at least the specified 'bytes', relocating the elements.
+  void grow(std::size_t bytes);
+};
+
+class PackedPrintableValues::const_iterator
+{
+  PackedPrintableValues const* values_;
+  std::size_t                  index_;
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type        = lib::PrintableValueProtocol;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = lib::PrintableValueProtocol const*;
+  using reference         = lib::PrintableValueProtocol const&;
+
+  const_iterator(PackedPrintableValues const* values, std::size_t index) noexcept
+  : values_(values), index_(index) {}
+
+  reference operator *  () const noexcept { return (*values_)[index_]; }
+  pointer   operator -> () const noexcept { return &**this; }
+  reference operator [] (difference_type n) const noexcept { return *(*this + n); }
+
+  const_iterator& operator ++ () noexcept { ++index_; return *this; }
+  const_iterator& operator -- () noexcept { --index_; return *this; }
+  const_iterator  operator ++ (int) noexcept { auto tmp = *this; ++index_; return tmp; }
+  const_iterator  operator -- (int) noexcept { auto tmp = *this; --index_; return tmp; }
+  const_iterator& operator += (difference_type n) noexcept { index_ += n; return *this; }
+  const_iterator& operator -= (difference_type n) noexcept { index_ -= n; return *this; }
+
+  friend const_iterator operator + (const_iterator it, difference_type n) noexcept { return it += n; }
+  friend const_iterator operator + (difference_type n, const_iterator it) noexcept { return it += n; }
+  friend const_iterator operator - (const_iterator it, difference_type n) noexcept { return it -= n; }
+  friend difference_type operator - (const_iterator lhs, const_iterator rhs) noexcept {
+    return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+  }
+
+  friend bool operator == (const_iterator lhs, const_iterator rhs) noexcept { return lhs.index_ == rhs.index_; }
+  friend bool operator != (const_iterator lhs, const_iterator rhs) noexcept { return lhs.index_ != rhs.index_; }
+  friend bool operator <  (const_iterator lhs, const_iterator rhs) noexcept { return lhs.index_ <  rhs.index_; }
+  friend bool operator >  (const_iterator lhs, const_iterator rhs) noexcept { return lhs.index_ >  rhs.index_; }
+  friend bool operator <= (const_iterator lhs, const_iterator rhs) noexcept { return lhs.index_ <= rhs.index_; }
+  friend bool operator >= (const_iterator lhs, const_iterator rhs) noexcept { return lhs.index_ >= rhs.index_; }
+};
+
+} // namespace lib
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // max
+#include <cassert>
+#include <new>       // launder, align_val_t
+#include <utility>   // move, swap
+
+namespace lib::detail {
+
+// Alignment of the buffer, and thus maximum alignment of the elements.
+inline constexpr std::size_t packed_alignment = alignof(std::max_align_t);
+
+// Return the specified 'offset' rounded up to a multiple of 'packed_alignment'.
+constexpr std::size_t packed_align(std::size_t offset) noexcept {
+  return (offset + packed_alignment - 1) / packed_alignment * packed_alignment;
+}
+
+// Return a pointer to the object of type 'A' at the specified 'storage'.
+template<class A>
+A* packed_object(void* storage) noexcept {
+  return std::launder(static_cast<A*>(storage));
+}
+
+template<class A>
+A const* packed_object(void const* storage) noexcept {
+  return std::launder(static_cast<A const*>(storage));
+}
+
+// Table of the operations on elements of type 'A'.
+template<class A>
+struct PackedOperations
+{
+  static void copy(void const* from, void* to) {
+    ::new (to) A(*lib::detail::packed_object<A>(from));
+  }
+  static void relocate(void* from, void* to) noexcept {
+    auto const source = lib::detail::packed_object<A>(from);
+    ::new (to) A(std::move(*source));
+    source->~A();
+  }
+  static void destroy(void* obj) noexcept {
+    lib::detail::packed_object<A>(obj)->~A();
+  }
+};
+
+} // namespace lib::detail
+
+inline void lib::PackedPrintableValues::Deallocate::operator () (
+                                            std::byte* storage) const noexcept
+{
+  ::operator delete(storage, std::align_val_t{lib::detail::packed_alignment});
+}
+
+inline lib::PackedPrintableValues::PackedPrintableValues() noexcept
+: storage_(nullptr)
+, size_(0)
+, capacity_(0)
+{ }
+
+inline lib::PackedPrintableValues::PackedPrintableValues(
+                                          PackedPrintableValues const& other)
+: PackedPrintableValues()
+{
+  reserve(other.size_);
+  elements_.reserve(other.elements_.size());
+  // Clone all the elements, keeping the same layout.
+  for (auto const& element : other.elements_) {
+    element.operations->copy(other.storage_.get() + element.offset,
+                             storage_.get() + element.offset);
+    elements_.push_back(element);
+  }
+  size_ = other.size_;
+}
+
+inline lib::PackedPrintableValues::PackedPrintableValues(
+                                      PackedPrintableValues && other) noexcept
+: storage_(std::move(other.storage_))
+, size_(std::exchange(other.size_, 0))
+, capacity_(std::exchange(other.capacity_, 0))
+, elements_(std::move(other.elements_))
+{
+  other.elements_.clear();
+}
+
+inline lib::PackedPrintableValues::~PackedPrintableValues() noexcept
+{
+  clear();
+}
+
+inline auto lib::PackedPrintableValues::operator = (
+                              PackedPrintableValues const& other)
+-> PackedPrintableValues&
+{
+  // A variation of the copy-and-swap idiom.
+  auto tmp = other;
+  *this = std::move(tmp);
+  return *this;
+}
+
+inline auto lib::PackedPrintableValues::operator = (
+                              PackedPrintableValues && other) noexcept
+-> PackedPrintableValues&
+{
+  clear();
+  storage_  = std::move(other.storage_);
+  size_     = std::exchange(other.size_, 0);
+  capacity_ = std::exchange(other.capacity_, 0);
+  elements_ = std::move(other.elements_);
+  other.elements_.clear();
+  return *this;
+}
+
+template<class T>
+void lib::PackedPrintableValues::push_back(T obj)
+{
+  using Adapter = lib::PrintableValueAdapter<T>;
+  static_assert( alignof(Adapter) <= lib::detail::packed_alignment,
+                 "over-aligned types are not supported" );
+  static_assert( std::is_nothrow_move_constructible_v<T>,
+                 "T must be nothrow move constructible, to be relocated" );
+  static Operations const operations = { &lib::detail::PackedOperations<Adapter>::copy
+                                       , &lib::detail::PackedOperations<Adapter>::relocate
+                                       , &lib::detail::PackedOperations<Adapter>::destroy };
+
+  auto const offset = lib::detail::packed_align(size_);
+  if (offset + sizeof(Adapter) > capacity_) {
+    grow(offset + sizeof(Adapter));
+  }
+  elements_.reserve(elements_.size() + 1); // so that 'push_back' cannot throw
+  auto const adapter = ::new (storage_.get() + offset) Adapter(std::move(obj));
+  auto const base = static_cast<lib::PrintableValueProtocol const*>(adapter);
+  auto const base_offset = static_cast<std::size_t>(
+            reinterpret_cast<std::byte const*>(base) - storage_.get());
+  elements_.push_back(Element{offset, base_offset, &operations});
+  size_ = offset + sizeof(Adapter);
+}
+
+inline void lib::PackedPrintableValues::clear() noexcept
+{
+  for (auto const& element : elements_) {
+    element.operations->destroy(storage_.get() + element.offset);
+  }
+  elements_.clear();
+  size_ = 0;
+}
+
+inline void lib::PackedPrintableValues::reserve(std::size_t bytes)
+{
+  if (bytes > capacity_) grow(bytes);
+}
+
+inline std::size_t lib::PackedPrintableValues::size() const noexcept
+{
+  return elements_.size();
+}
+
+inline bool lib::PackedPrintableValues::empty() const noexcept
+{
+  return elements_.empty();
+}
+
+inline auto lib::PackedPrintableValues::operator [] (std::size_t index) const noexcept
+-> lib::PrintableValueProtocol const&
+{
+  assert( index < elements_.size() );
+  auto const storage = storage_.get() + elements_[index].base_offset;
+  return *std::launder(reinterpret_cast<lib::PrintableValueProtocol const*>(storage));
+}
+
+inline auto lib::PackedPrintableValues::begin() const noexcept -> const_iterator
+{
+  return const_iterator(this, 0);
+}
+
+inline auto lib::PackedPrintableValues::end() const noexcept -> const_iterator
+{
+  return const_iterator(this, elements_.size());
+}
+
+inline void lib::PackedPrintableValues::print_all() const
+{
+  for (auto const& value : *this) {
+    value.print();
+  }
+}
+
+inline void lib::PackedPrintableValues::grow(std::size_t bytes)
+{
+  auto const capacity = std::max(bytes, 2 * capacity_);
+  std::unique_ptr<std::byte[], Deallocate> storage(static_cast<std::byte*>(
+          ::operator new(capacity, std::align_val_t{lib::detail::packed_alignment})));
+  // Offsets are preserved, so that only the objects need to be relocated.
+  for (auto const& element : elements_) {
+    element.operations->relocate(storage_.get() + element.offset,
+                                 storage.get()  + element.offset);
+  }
+  storage_  = std::move(storage);
+  capacity_ = capacity;
+}
+
+#endif // PACKED_PRINTABLE_VALUES_HPP_INCLUDE_GUARD
@@ -0,0 +1,141 @@
+#ifndef PIECEWISE_HAZARD_SURVIVAL_HPP_INCLUDE_GUARD
+#define PIECEWISE_HAZARD_SURVIVAL_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+#include <vector>
+
+#include "config.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class implements the 'pdg::Survival' protocol with a piecewise constant hazard
+// rate: given the knots '0 = t_0 < t_1 < ... < t_n', the hazard rate is 'h_i' on
+// '[t_i, t_{i+1})', and 'h_n' after 't_n'. The cumulative hazard, piecewise linear,
+// is computed exactly, and each query costs one binary search over the knots.
+class PiecewiseHazardSurvival : public pdg::Survival
+{
+  std::vector<pdg::Time> knots_;
+  std::vector<double>    hazards_;
+  // Cumulative hazard at each knot.
+  std::vector<double>    cumulative_;
+
+public:
+  // Create a curve whose hazard rate is 'hazards[i]' from 'knots[i]' until the next
+  // knot, for the specified 'knots' and 'hazards'. The behaviour is undefined unless
+  // 'knots' and 'hazards' have the same non-zero size, 'knots[0] == 0', 'knots' is
+  // strictly increasing, and 'hazards' are finite and non-negative.
+  PiecewiseHazardSurvival(std::vector<pdg::Time> knots, std::vector<double> hazards);
+
+  // Return the knots of this curve.
+  std::vector<pdg::Time> const& knots() const noexcept;
+  // Return the hazard rates of this curve, one per knot.
+  std::vector<double> const& hazards() const noexcept;
+
+private:
+  // Return the index of the last knot not after the specified 'T'.
+  std::size_t segment(pdg::Time const& T) const noexcept;
+
+  pdg::Probability survival_prob_impl(pdg::Time const& T) const override;
+  double hazard_rate_impl(pdg::Time const& T) const override;
+  pdg::Probability conditional_survival_prob_impl(
+                          pdg::Time const& T, pdg::Time const& t) const override;
+  double cumulative_hazard_impl(pdg::Time const& T) const override;
+  void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                    double* result) const override;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // upper_bound
+#include <cassert>
+#include <cmath>     // exp
+#include <utility>   // move
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+PDG_INLINE pdg::PiecewiseHazardSurvival::PiecewiseHazardSurvival(
+                             std::vector<pdg::Time> knots, std::vector<double> hazards)
+: knots_(std::move(knots))
+, hazards_(std::move(hazards))
+, cumulative_(knots_.size())
+{
+  assert( !knots_.empty() );
+  assert( knots_.size() == hazards_.size() );
+  assert( knots_[0] == 0 );
+  cumulative_[0] = 0;
+  for (std::size_t i = 1; i != knots_.size(); ++i) {
+    assert( knots_[i - 1] < knots_[i] );
+    assert( 0 <= hazards_[i - 1] );
+    cumulative_[i] = cumulative_[i - 1] + hazards_[i - 1] * (knots_[i] - knots_[i - 1]);
+  }
+  assert( 0 <= hazards_.back() );
+}
+
+PDG_INLINE std::vector<pdg::Time> const&
+pdg::PiecewiseHazardSurvival::knots() const noexcept
+{
+  return knots_;
+}
+
+PDG_INLINE std::vector<double> const&
+pdg::PiecewiseHazardSurvival::hazards() const noexcept
+{
+  return hazards_;
+}
+
+PDG_INLINE std::size_t pdg::PiecewiseHazardSurvival::segment(
+                                                 pdg::Time const& T) const noexcept
+{
+  return std::upper_bound(knots_.begin() + 1, knots_.end(), T) - knots_.begin() - 1;
+}
+
+PDG_INLINE pdg::Probability pdg::PiecewiseHazardSurvival::survival_prob_impl(
+                                                          pdg::Time const& T) const
+{
+  return std::exp(- cumulative_hazard_impl(T));
+}
+
+PDG_INLINE double pdg::PiecewiseHazardSurvival::hazard_rate_impl(
+                                                          pdg::Time const& T) const
+{
+  return hazards_[segment(T)];
+}
+
+PDG_INLINE pdg::Probability pdg::PiecewiseHazardSurvival::conditional_survival_prob_impl(
+                                     pdg::Time const& T, pdg::Time const& t) const
+{
+  return std::exp(cumulative_hazard_impl(t) - cumulative_hazard_impl(T));
+}
+
+PDG_INLINE double pdg::PiecewiseHazardSurvival::cumulative_hazard_impl(
+                                                          pdg::Time const& T) const
+{
+  auto const i = segment(T);
+  return cumulative_[i] + hazards_[i] * (T - knots_[i]);
+}
+
+PDG_INLINE void pdg::PiecewiseHazardSurvival::cumulative_hazard_batch_impl(
+                  pdg::Time const* T, std::size_t count, double* result) const
+{
+  // Increasing times, the common case, are located by advancing from the segment
+  // of the previous one.
+  std::size_t i = 0;
+  for (std::size_t k = 0; k != count; ++k) {
+    assert( T[k] >= 0 );
+    if (T[k] < knots_[i]) {
+      i = segment(T[k]);
+    }
+    else {
+      while (i + 1 != knots_.size() && knots_[i + 1] <= T[k]) ++i;
+    }
+    result[k] = cumulative_[i] + hazards_[i] * (T[k] - knots_[i]);
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // PIECEWISE_HAZARD_SURVIVAL_HPP_INCLUDE_GUARD
@@ -4,152 +4,20 @@
 #include <memory> // unique_ptr
 #include <type_traits>
 
-namespace ttl { // type traits library
+#include "PrintableValueProtocol.hpp"
+#include "is_printable.hpp"
+#include "is_regular.hpp"
 
-// Movable
-template<class T>
-using is_movable = std::conjunction < std::is_object<T>
-                                    , std::is_move_constructible<T>
-                                    , std::is_assignable<T&, T>
-                                    , std::is_swappable<T> >;
-// Copyable
-template<class T>
-using is_copyable = std::conjunction < ttl::is_movable<T>
-                                     , std::is_copy_constructible<T>
-                                     , std::is_assignable<T&, T const&>
-                                     , std::is_assignable<T&, T&>
-                                     , std::is_assignable<T&, T> >;
-// Semiregular
-template<class T>
-using is_semiregular = std::conjunction < ttl::is_copyable<T>
-                                        , std::is_default_constructible<T> >;
-
-// Equality Comparable
-template<class T>
-struct is_equality_comparable; // Implemented below
-
-// Regular
-template<class T>
-using is_regular = std::conjunction < ttl::is_semiregular<T>
-                                    , ttl::is_equality_comparable<T> >;
-
-// Helper types and variables
-template<class T> using is_movable_t             = typename is_movable<T>::type;
-template<class T> using is_copyable_t            = typename is_copyable<T>::type;
-template<class T> using is_semiregular_t         = typename is_semiregular<T>::type;
-template<class T> using is_equality_comparable_t = typename is_equality_comparable<T>::type;
-template<class T> using is_regular_t             = typename is_regular<T>::type;
-
-template<class T> constexpr bool is_movable_v             =  is_movable<T>::value;
-template<class T> constexpr bool is_copyable_v            =  is_copyable<T>::value;
-template<class T> constexpr bool is_semiregular_v         =  is_semiregular<T>::value;
-template<class T> constexpr bool is_equality_comparable_v =  is_equality_comparable<T>::value;
-template<class T> constexpr bool is_regular_v             =  is_regular<T>::value;
-
-} // namespace ttl
-
-// Implementation /////////////////////////////////////////////////////////////
-
-namespace {
-
-// Detection idiom
-template<template<class> class expression, class T, class = void>
-struct detector : std::false_type {};
-
-template<template<class> class expression, class T>
-struct detector< expression, T, std::void_t< expression<T> > >
-: std::true_type {};
-
-template<template<class> class expression, class T>
-using is_detected = detector<expression, T>;
-
-template<template<class> class expression, class T, class R, class = void>
-struct type_detector : std::false_type {};
-
-template<template<class> class expression, class T, class R>
-struct type_detector< expression, T, R, std::void_t< expression<T> > >
-: std::is_same<expression<T>, R> {};
-
-template<template<class> class expression, class T, class R>
-using is_detected_type = type_detector<expression, T, R>;
-
-// Expressions for equality comparison
-
-template<class T>
-using equality_compare_t   = decltype(std::declval<T const&>() == std::declval<T const&>());
-template<class T>
-using inequality_compare_t = decltype(std::declval<T const&>() != std::declval<T const&>());
-
-} // unnamed namespace
-
-template<class T>
-struct ttl::is_equality_comparable
-: std::conjunction < ::is_detected_type<equality_compare_t, T, bool>
-                   , ::is_detected_type<inequality_compare_t, T, bool> > {};
-                   
 namespace lib {
 
-/******************************************************************************
-* class lib::PrintableValueProtocol
-******************************************************************************/
-// This protocol class provides a pure abstract interface and contract which
-// models objects having a value that can printed to 'stdout'.
-// It provides a member function 'print' that prints the value of the object
-// to 'stdout'. Two 'PrintableValueProtocol' objects have the same value if
-// their respective output to 'stdout' is the same. Value semantics are mimicked 
-// using 'unique_ptr': in particular copies are generated using the virtual
-// copy idiom, and default construction is mimicked having a global instance
-// 'PrintableValueProtocol::Default' whose value is "null" (it prints nothing).
-// For ease of implementation, the type is (morally) only semiregular.
-class PrintableValueProtocol
-{
-public:
-  // Destroy this object.
-  virtual ~PrintableValueProtocol() noexcept = 0;
-  // Suppress assignment through abstract protocol.
-  PrintableValueProtocol& operator = (PrintableValueProtocol const&) = delete;
-
-  // Print this object to 'stdout'.
-  void print() const;
-
-  // Return a pointer having unique ownership of a 'PrintableValueProtocol'
-  // object having the same value of this object.
-  std::unique_ptr<PrintableValueProtocol> clone() const;
-
-  // A 'PrintableValueProtocol' object whose value is "null". That is,
-  // 'PrintableValueProtocol::Default.print()' prints nothing to 'stdout'.
-  static PrintableValueProtocol const& Default;
-
-  // Return a pointer having unique ownership of a 'PrintableValueProtocol'
-  // object having "null" value.
-  // Note this is equivalent to calling 'PrintableValueProtocol::Default.clone()'.
-  static std::unique_ptr<PrintableValueProtocol> getDefault();
-
-private: /* virtual implementation */
-  // Implement the 'print' contract.
-  virtual void print_impl() const = 0;
-  // Implement the 'clone' contract.
-  virtual std::unique_ptr<PrintableValueProtocol> clone_impl() const = 0;
-};
-
-// Return 'true' if the specified 'lhs' and 'rhs' have the same value,
-// and 'false' otherwise. Two 'PrintableValueProtocol' objects have the same
-// value if their respective outputs to 'stdout' are equal.
-bool operator == (PrintableValueProtocol const& lhs,
-                  PrintableValueProtocol const& rhs) = delete;
-
-// Return 'true' if the specified 'lhs' and 'rhs' do not have the same value,
-// and 'false' otherwise. Two 'PrintableValueProtocol' objects do not have the
-// same value if their respective outputs to 'stdout' are not equal.
-bool operator != (PrintableValueProtocol const& lhs,
-                  PrintableValueProtocol const& rhs) = delete;
-
 /******************************************************************************
 * class lib::PrintableValueAdapter
 ******************************************************************************/
 // This class provides an "adapter" from the specified 'T' to the
 // 'lib::PrintableValueProtocol' abstract protocol. The adapter reroutes the
-// implementation through a specific customization point, 'print_cp'.
+// implementation through specific customization points: 'print_cp' for
+// printing, 'serialize_cp' and 'deserialize_cp' for the binary format, and
+// 'emit_cp' for structured formats.
 // 'T' must be semiregular and have value-semantics.
 template <class T>
 class PrintableValueAdapter : public lib::PrintableValueProtocol
@@ -157,26 +25,70 @@ class PrintableValueAdapter : public lib::PrintableValueProtocol
   static_assert(ttl::is_semiregular_v<T>, "T must be semiregular");
 
   T impl_; // concrete implementation to be adapted.
+
+  // Tag identifying 'T' in the binary format, or '0' if not registered.
+  static inline type_tag tag_ = 0;
 public:
   // Create an adapter to the 'lib::PrintableValueProtocol' protocol using
   // the specified 'obj'.
   /*implicit*/ PrintableValueAdapter(T obj);
 
+  // Associate the specified 'tag' to adapters of 'T', so that they can be
+  // serialized and deserialized. A 'lib::serialization_error' is thrown if
+  // 'tag' is '0' or has already been registered. Note that registration is
+  // not thread-safe, and should happen at startup.
+  static void register_type(type_tag tag);
+
+protected:
+  // Return a reference to the adapted object.
+  T const& value() const noexcept;
+
 private:
   // Implement the 'lib::PrintableValueProtocol' protocol by forwarding the
   // call to the customization point 'lib::PrintableValueAdapter_print_cp'.
   void print_impl() const override;
   // Implement the 'lib::PrintableValueProtocol' protocol by copying the
   // adapted object.
-  std::unique_ptr<PrintableValueProtocol> clone_impl() const override;
+  PrintableValueProtocol::pointer clone_impl() const override;
+  // Implement the 'lib::PrintableValueProtocol' protocol by returning the
+  // tag registered for 'T'.
+  type_tag type_tag_impl() const override;
+  // Implement the 'lib::PrintableValueProtocol' protocol by forwarding the
+  // call to the customization point 'serialize_cp'.
+  void serialize_impl(std::string& buffer) const override;
+  // Implement the 'lib::PrintableValueProtocol' protocol by forwarding the
+  // call to the customization point 'emit_cp'.
+  void emit_impl(lib::FieldEmitter& emitter) const override;
+  // Return a pointer having unique ownership of an adapter constructed from
+  // the specified 'payload', using the customization point 'deserialize_cp'.
+  static PrintableValueProtocol::pointer make(std::string_view payload);
 
 private: // Customization point for 'lib::PrintableValueAdapter'
   // Clients are free to specialize the following function template for
   // their types, to match the behaviour of their respective contracts.
 
   // Print the specified 'obj' to 'stdout'.
-  // Note that unless specialized, 'fmt::print("{}", obj)' is returned.
+  // Note that unless specialized, 'lib::print(obj)' is called.
   static void print_cp(T const& obj);
+
+  // Append the binary encoding of the specified 'obj' to the specified 'buffer'.
+  // Note that unless specialized, 'lib::serialize(obj, buffer)' is called if
+  // 'lib::is_serializable_v<T>', and a 'lib::serialization_error' is thrown
+  // otherwise.
+  static void serialize_cp(T const& obj, std::string& buffer);
+
+  // Decode an object from the front of the specified 'buffer', and remove the
+  // consumed bytes from it.
+  // Note that unless specialized, 'lib::deserialize<T>(buffer)' is returned if
+  // 'lib::is_serializable_v<T>', and a 'lib::serialization_error' is thrown
+  // otherwise.
+  static T deserialize_cp(std::string_view& buffer);
+
+  // Write the fields of the specified 'obj' to the specified 'emitter'.
+  // Note that unless specialized, 'lib::fields<T>{}(obj, emitter)' is called,
+  // which throws a 'lib::serialization_error' if neither 'lib::fields<T>' is
+  // specialized nor 'fmt' can format 'T'.
+  static void emit_cp(T const& obj, lib::FieldEmitter& emitter);
 };
 
 } // namespace lib
@@ -185,72 +97,125 @@ private: // Customization point for 'lib::PrintableValueAdapter'
 // Implementation
 ///////////////////////////////////////////////////////////////////////////////
 #include <utility> // move
-#include <fmt/core.h>
 
-lib::PrintableValueProtocol::~PrintableValueProtocol() noexcept = default;
+#include "serializer.hpp"
+#include "structured_output.hpp"
 
-void lib::PrintableValueProtocol::print() const {
-  return print_impl();
-}
+template<class T>
+lib::PrintableValueAdapter<T>::PrintableValueAdapter(T obj)
+: impl_(std::move(obj))
+{ }
 
-auto lib::PrintableValueProtocol::clone() const
--> std::unique_ptr<lib::PrintableValueProtocol> {
-  return clone_impl();
+template<class T>
+void lib::PrintableValueAdapter<T>::register_type(type_tag tag)
+{
+  PrintableValueProtocol::register_type(tag, &make);
+  tag_ = tag;
 }
 
-namespace {
+template<class T>
+T const& lib::PrintableValueAdapter<T>::value() const noexcept
+{
+  return impl_;
+}
 
-// This class provides an implementation of the 'lib::PrintableValueProtocol'
-// protocol. It models a "null" value, that prints nothing to 'stdout'.
-class NullPrintableValue : public lib::PrintableValueProtocol
+template<class T>
+void lib::PrintableValueAdapter<T>::print_impl() const
 {
-  // Do nothing.
-  void print_impl() const final;
-  // Return a pointer having unique ownership of a 'NullPrintableValue' object.
-  std::unique_ptr<lib::PrintableValueProtocol> clone_impl() const final;
-};
+  print_cp(impl_);
+}
 
-void NullPrintableValue::print_impl() const {
- // Intentionally blank.
+template<class T>
+auto lib::PrintableValueAdapter<T>::clone_impl() const
+-> PrintableValueProtocol::pointer
+{
+  return std::make_unique<lib::PrintableValueAdapter<T>>(impl_);
 }
 
-auto NullPrintableValue::clone_impl() const
--> std::unique_ptr<lib::PrintableValueProtocol> {
-  return std::make_unique<NullPrintableValue>();
+template<class T>
+auto lib::PrintableValueAdapter<T>::type_tag_impl() const -> type_tag
+{
+  if (tag_ == 0) throw lib::serialization_error{};
+  return tag_;
 }
 
-} // unnamed namespace
+template<class T>
+void lib::PrintableValueAdapter<T>::serialize_impl(std::string& buffer) const
+{
+  serialize_cp(impl_, buffer);
+}
 
-lib::PrintableValueProtocol const& lib::PrintableValueProtocol::Default
-  = ::NullPrintableValue{};
+template<class T>
+void lib::PrintableValueAdapter<T>::emit_impl(lib::FieldEmitter& emitter) const
+{
+  emit_cp(impl_, emitter);
+}
 
- auto lib::PrintableValueProtocol::getDefault()
- -> std::unique_ptr<lib::PrintableValueProtocol> {
-  return lib::PrintableValueProtocol::Default.clone();
+template<class T>
+auto lib::PrintableValueAdapter<T>::make(std::string_view payload)
+-> PrintableValueProtocol::pointer
+{
+  auto result = std::make_unique<lib::PrintableValueAdapter<T>>(
+                                                     deserialize_cp(payload));
+  if (!payload.empty()) throw lib::serialization_error{}; // trailing bytes
+  return result;
 }
 
 template<class T>
-lib::PrintableValueAdapter<T>::PrintableValueAdapter(T obj)
-: impl_(std::move(obj))
-{ }
+void lib::PrintableValueAdapter<T>::print_cp(T const& obj)
+{
+  lib::print(obj);
+}
 
 template<class T>
-void lib::PrintableValueAdapter<T>::print_impl() const
+void lib::PrintableValueAdapter<T>::serialize_cp(T const& obj,
+                                                 std::string& buffer)
 {
-  print_cp(impl_);
+  if constexpr (lib::is_serializable_v<T>) {
+    lib::serialize(obj, buffer);
+  }
+  else {
+    throw lib::serialization_error{};
+  }
 }
 
 template<class T>
-auto lib::PrintableValueAdapter<T>::clone_impl() const
--> std::unique_ptr<PrintableValueProtocol>
+T lib::PrintableValueAdapter<T>::deserialize_cp(std::string_view& buffer)
 {
-  return std::make_unique<lib::PrintableValueAdapter<T>>(impl_);
+  if constexpr (lib::is_serializable_v<T>) {
+    return lib::deserialize<T>(buffer);
+  }
+  else {
+    throw lib::serialization_error{};
+  }
 }
 
 template<class T>
-void lib::PrintableValueAdapter<T>::print_cp(T const& obj)
+void lib::PrintableValueAdapter<T>::emit_cp(T const& obj,
+                                            lib::FieldEmitter& emitter)
 {
-  fmt::print("{}", obj);
+  lib::fields<T>{}(obj, emitter);
 }
 
+// Explicit instantiations ////////////////////////////////////////////////////
+
+// Declare that 'lib::PrintableValueAdapter<T>' is explicitly instantiated in
+// another translation unit, which must then use the macro below; this avoids
+// instantiating it in every translation unit using it. Note that the
+// customization points of 'T' must be specialized, if at all, before either.
+#define PDG_EXTERN_PRINTABLE_VALUE_ADAPTER(...) \
+  extern template class lib::PrintableValueAdapter<__VA_ARGS__>
+
+// Explicitly instantiate 'lib::PrintableValueAdapter<T>'.
+#define PDG_INSTANTIATE_PRINTABLE_VALUE_ADAPTER(...) \
+  template class lib::PrintableValueAdapter<__VA_ARGS__>
+
+// In the compiled-library mode, the adapters of the most common types are
+// instantiated by the library; see "src/PrintableValueAdapter.cpp".
+#if defined(PDG_COMPILED_LIBRARY)
+PDG_EXTERN_PRINTABLE_VALUE_ADAPTER(int);
+PDG_EXTERN_PRINTABLE_VALUE_ADAPTER(double);
+PDG_EXTERN_PRINTABLE_VALUE_ADAPTER(std::string);
+#endif
+
 #endif // PRINTABLE_VALUE_ADAPTER_HPP_INCLUDE_GUARD
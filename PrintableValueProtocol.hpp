@@ -1,10 +1,17 @@
 #ifndef PRINTABLE_VALUE_PROTOCOL_HPP_INCLUDE_GUARD
 #define PRINTABLE_VALUE_PROTOCOL_HPP_INCLUDE_GUARD
 
+#include <cstdint>
 #include <memory> // unique_ptr
+#include <string>
+#include <string_view>
+
+#include "config.hpp"
 
 namespace lib {
 
+class FieldEmitter; // see 'structured_output.hpp'
+
 // This protocol class provides a pure abstract interface and contract which
 // models objects having a value that can printed to 'stdout'.
 // It provides a member function 'print' that prints the value of the object
@@ -13,10 +20,48 @@ namespace lib {
 // using 'unique_ptr': in particular copies are generated using the virtual
 // copy idiom, and default construction is mimicked having a global instance
 // 'PrintableValueProtocol::Default' whose value is "null" (it prints nothing).
+// Pointers to "null" values all share 'Default', without owning it, so that
+// creating and copying them never allocates.
+// Values can also be serialized to a compact binary format using 'serialize',
+// and reconstructed using 'deserialize': each concrete type is identified in
+// the binary format by a 'type_tag', associated to it by 'register_type'.
+// Finally, values can be written as records of named fields in a structured
+// format, such as JSON or CSV, using 'emit'.
 // For ease of implementation, the type is (morally) only semiregular.
 class PrintableValueProtocol
 {
 public:
+  // Deleter for pointers to 'PrintableValueProtocol' objects: it destroys the
+  // pointed-to object, unless it is the shared 'Default'. The deleter has no
+  // state, so that 'pointer' is no larger than a raw pointer, and 'reset' or
+  // 'release' behave as for 'std::unique_ptr<PrintableValueProtocol>'.
+  struct deleter
+  {
+    deleter() noexcept = default;
+    // Allow conversions from 'std::unique_ptr<U>', e.g. 'std::make_unique'.
+    template<class U>
+    /*implicit*/ deleter(std::default_delete<U> const&) noexcept {}
+
+    // Destroy the object pointed to by the specified 'ptr', unless it is
+    // 'Default'.
+    void operator () (PrintableValueProtocol* ptr) const noexcept;
+  };
+
+  // Alias for a pointer having unique ownership of a 'PrintableValueProtocol'
+  // object; the only exception is 'Default', which is shared and never destroyed.
+  // Note that this type replaces 'std::unique_ptr<PrintableValueProtocol>' as
+  // the return type of 'clone', 'clone_impl' and 'getDefault': it converts from
+  // it, but not to it, so implementations of 'clone_impl' and callers storing
+  // the result in a 'std::unique_ptr<PrintableValueProtocol>' must be updated.
+  using pointer = std::unique_ptr<PrintableValueProtocol, deleter>;
+
+  // Alias for the type of the tags identifying concrete types in the binary
+  // format. The tag '0' is reserved for the "null" value.
+  using type_tag = std::uint32_t;
+
+  // Alias for functions reconstructing an object from the specified payload.
+  using factory = pointer (*)(std::string_view payload);
+
   // Destroy this object.
   virtual ~PrintableValueProtocol() noexcept = 0;
   // Suppress assignment through abstract protocol.
@@ -27,22 +72,60 @@ public:
 
   // Return a pointer having unique ownership of a 'PrintableValueProtocol'
   // object having the same value of this object.
-  std::unique_ptr<PrintableValueProtocol> clone() const;
+  pointer clone() const;
 
   // A 'PrintableValueProtocol' object whose value is "null". That is,
   // 'PrintableValueProtocol::Default.print()' prints nothing to 'stdout'.
   static PrintableValueProtocol const& Default;
 
+  // Return a pointer to a 'PrintableValueProtocol' object having "null" value.
+  // Note this is equivalent to calling 'PrintableValueProtocol::Default.clone()',
+  // and that no memory is allocated: the returned pointer refers to 'Default'.
+  static pointer getDefault() noexcept;
+
+  // Write the value of this object as a record to the specified 'emitter'.
+  // A 'lib::serialization_error' is thrown if the concrete type of this
+  // object does not support structured output.
+  // Note that the record of a "null" value has no fields.
+  void emit(lib::FieldEmitter& emitter) const;
+
+  // Append the binary representation of this object to the specified 'buffer':
+  // the 'type_tag' of its concrete type and the length of its payload, both
+  // encoded as little-endian 32-bit integers, followed by the payload itself.
+  // A 'lib::serialization_error' is thrown if the concrete type of this
+  // object has not been registered.
+  void serialize(std::string& buffer) const;
+
   // Return a pointer having unique ownership of a 'PrintableValueProtocol'
-  // object having "null" value.
-  // Note this is equivalent to calling 'PrintableValueProtocol::Default.clone()'.
-  static std::unique_ptr<PrintableValueProtocol> getDefault();
+  // object reconstructed from the binary representation at the front of the
+  // specified 'buffer', and remove the consumed bytes from 'buffer'. A
+  // 'lib::serialization_error' is thrown if 'buffer' is malformed, or if its
+  // 'type_tag' has not been registered.
+  static pointer deserialize(std::string_view& buffer);
+
+protected:
+  // Associate the specified 'tag' to the specified 'make', used by
+  // 'deserialize' to reconstruct objects from payloads having that 'tag'.
+  // A 'lib::serialization_error' is thrown if 'tag' is '0' or has already
+  // been registered. Note that registration is not thread-safe, and should
+  // happen at startup.
+  static void register_type(type_tag tag, factory make);
 
 private: /* virtual implementation */
   // Implement the 'print' contract.
   virtual void print_impl() const = 0;
   // Implement the 'clone' contract.
-  virtual std::unique_ptr<PrintableValueProtocol> clone_impl() const = 0;
+  virtual pointer clone_impl() const = 0;
+  // Return the 'type_tag' identifying the concrete type of this object. A
+  // 'lib::serialization_error' is thrown if it has not been registered, which
+  // is what the default implementation does.
+  virtual type_tag type_tag_impl() const;
+  // Append the payload of the 'serialize' contract to the specified 'buffer'.
+  // The default implementation throws a 'lib::serialization_error'.
+  virtual void serialize_impl(std::string& buffer) const;
+  // Write the fields of the 'emit' contract to the specified 'emitter'.
+  // The default implementation throws a 'lib::serialization_error'.
+  virtual void emit_impl(lib::FieldEmitter& emitter) const;
 };
 
 // Return 'true' if the specified 'lhs' and 'rhs' have the same value,
@@ -62,19 +145,114 @@ bool operator != (PrintableValueProtocol const& lhs,
 ///////////////////////////////////////////////////////////////////////////////
 // Implementation
 ///////////////////////////////////////////////////////////////////////////////
+#include <limits>
+#include <unordered_map>
+
+#include "serializer.hpp"
+#include "structured_output.hpp"
 
-lib::PrintableValueProtocol::~PrintableValueProtocol() noexcept = default;
+#if PDG_DEFINE_NON_TEMPLATES
 
-void lib::PrintableValueProtocol::print() const {
+PDG_INLINE lib::PrintableValueProtocol::~PrintableValueProtocol() noexcept = default;
+
+PDG_INLINE void lib::PrintableValueProtocol::deleter::operator () (
+                                    lib::PrintableValueProtocol* ptr) const noexcept
+{
+  if (ptr != &lib::PrintableValueProtocol::Default) {
+    delete ptr;
+  }
+}
+
+PDG_INLINE void lib::PrintableValueProtocol::print() const {
   return print_impl();
 }
 
-auto lib::PrintableValueProtocol::clone() const
--> std::unique_ptr<lib::PrintableValueProtocol> {
+PDG_INLINE auto lib::PrintableValueProtocol::clone() const
+-> lib::PrintableValueProtocol::pointer {
   return clone_impl();
 }
 
-namespace {
+namespace lib::detail {
+
+// Return the registry associating type tags to the factories of their types.
+PDG_INLINE auto printable_value_factories()
+-> std::unordered_map< lib::PrintableValueProtocol::type_tag
+                     , lib::PrintableValueProtocol::factory >& {
+  static std::unordered_map< lib::PrintableValueProtocol::type_tag
+                           , lib::PrintableValueProtocol::factory > registry;
+  return registry;
+}
+
+} // namespace lib::detail
+
+PDG_INLINE void lib::PrintableValueProtocol::serialize(std::string& buffer) const
+{
+  lib::serialize(type_tag_impl(), buffer);
+  // Reserve the length prefix, and fill it in once the payload is known.
+  auto const prefix = buffer.size();
+  lib::serialize(std::uint32_t{0}, buffer);
+  serialize_impl(buffer);
+  auto const size = buffer.size() - prefix - sizeof(std::uint32_t);
+  if (size > std::numeric_limits<std::uint32_t>::max()) {
+    throw lib::serialization_error{};
+  }
+  for (std::size_t i = 0; i != sizeof(std::uint32_t); ++i) { // little-endian
+    buffer[prefix + i] = static_cast<char>(static_cast<unsigned char>(size >> (8 * i)));
+  }
+}
+
+PDG_INLINE auto lib::PrintableValueProtocol::deserialize(std::string_view& buffer)
+-> lib::PrintableValueProtocol::pointer
+{
+  auto input = buffer;
+  auto const tag  = lib::deserialize<type_tag>(input);
+  auto const size = lib::deserialize<std::uint32_t>(input);
+  if (input.size() < size) throw lib::serialization_error{};
+  auto const payload = input.substr(0, size);
+  pointer result;
+  if (tag == 0) {
+    if (!payload.empty()) throw lib::serialization_error{};
+    result = getDefault();
+  }
+  else {
+    auto const& registry = lib::detail::printable_value_factories();
+    auto const it = registry.find(tag);
+    if (it == registry.end()) throw lib::serialization_error{};
+    result = it->second(payload);
+  }
+  input.remove_prefix(size);
+  buffer = input;
+  return result;
+}
+
+PDG_INLINE void lib::PrintableValueProtocol::emit(lib::FieldEmitter& emitter) const
+{
+  emitter.begin_record();
+  emit_impl(emitter);
+  emitter.end_record();
+}
+
+PDG_INLINE auto lib::PrintableValueProtocol::type_tag_impl() const
+-> lib::PrintableValueProtocol::type_tag {
+  throw lib::serialization_error{};
+}
+
+PDG_INLINE void lib::PrintableValueProtocol::serialize_impl(std::string&) const {
+  throw lib::serialization_error{};
+}
+
+PDG_INLINE void lib::PrintableValueProtocol::emit_impl(lib::FieldEmitter&) const {
+  throw lib::serialization_error{};
+}
+
+PDG_INLINE void lib::PrintableValueProtocol::register_type(type_tag tag, factory make)
+{
+  if (tag == 0) throw lib::serialization_error{};
+  auto const inserted = lib::detail::printable_value_factories().emplace(tag, make).second;
+  if (!inserted) throw lib::serialization_error{};
+}
+
+namespace lib::detail {
 
 // This class provides an implementation of the 'lib::PrintableValueProtocol'
 // protocol. It models a "null" value, that prints nothing to 'stdout'.
@@ -82,27 +260,53 @@ class NullPrintableValue : public lib::PrintableValueProtocol
 {
   // Do nothing.
   void print_impl() const final;
-  // Return a pointer having unique ownership of a 'NullPrintableValue' object.
-  std::unique_ptr<lib::PrintableValueProtocol> clone_impl() const final;
+  // Return a pointer to the shared 'lib::PrintableValueProtocol::Default'.
+  lib::PrintableValueProtocol::pointer clone_impl() const final;
+  // Return the tag reserved for "null" values, '0'.
+  lib::PrintableValueProtocol::type_tag type_tag_impl() const final;
+  // Do nothing: the payload of a "null" value is empty.
+  void serialize_impl(std::string& buffer) const final;
+  // Do nothing: the record of a "null" value has no fields.
+  void emit_impl(lib::FieldEmitter& emitter) const final;
 };
 
-void NullPrintableValue::print_impl() const {
+PDG_INLINE void NullPrintableValue::print_impl() const {
+ // Intentionally blank.
+}
+
+// The "null" value referred to by 'lib::PrintableValueProtocol::Default'.
+PDG_INLINE NullPrintableValue shared_null_value;
+
+PDG_INLINE auto NullPrintableValue::clone_impl() const
+-> lib::PrintableValueProtocol::pointer {
+  // All "null" values are equal, so 'Default' is shared rather than copied.
+  // The deleter of 'pointer' never destroys it.
+  return lib::PrintableValueProtocol::pointer(&shared_null_value);
+}
+
+PDG_INLINE auto NullPrintableValue::type_tag_impl() const
+-> lib::PrintableValueProtocol::type_tag {
+  return 0;
+}
+
+PDG_INLINE void NullPrintableValue::serialize_impl(std::string&) const {
  // Intentionally blank.
 }
 
-auto NullPrintableValue::clone_impl() const
--> std::unique_ptr<lib::PrintableValueProtocol> {
-  return std::make_unique<NullPrintableValue>();
+PDG_INLINE void NullPrintableValue::emit_impl(lib::FieldEmitter&) const {
+ // Intentionally blank.
 }
 
-} // unnamed namespace
+} // namespace lib::detail
 
-lib::PrintableValueProtocol const& lib::PrintableValueProtocol::Default
-  = ::NullPrintableValue{};
+PDG_INLINE lib::PrintableValueProtocol const& lib::PrintableValueProtocol::Default
+  = lib::detail::shared_null_value;
 
- auto lib::PrintableValueProtocol::getDefault()
- -> std::unique_ptr<lib::PrintableValueProtocol> {
+PDG_INLINE auto lib::PrintableValueProtocol::getDefault() noexcept
+ -> lib::PrintableValueProtocol::pointer {
   return lib::PrintableValueProtocol::Default.clone();
 }
 
+#endif // PDG_DEFINE_NON_TEMPLATES
+
 #endif // PRINTABLE_VALUE_PROTOCOL_HPP_INCLUDE_GUARD
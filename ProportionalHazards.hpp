@@ -0,0 +1,201 @@
+#ifndef PROPORTIONAL_HAZARDS_HPP_INCLUDE_GUARD
+#define PROPORTIONAL_HAZARDS_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "config.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class provides the Cox proportional-hazards model: the survival probability of
+// an individual with covariates 'x' is 'S(T|x) = S_0(T)^exp(beta . x)', where 'S_0' is
+// a baseline curve and 'beta' the coefficients of the model; equivalently, its
+// cumulative hazard is 'H(T|x) = exp(beta . x) H_0(T)'.
+// The batch functions evaluate a population of individuals at several times: the
+// baseline cumulative hazard is computed once per time, with one batched call, and
+// the individuals are then split among a number of threads, each computing the
+// linear predictors 'beta . x' of its individuals and filling their rows of the
+// result. Covariates are given as a row-major matrix, one row of 'covariates()'
+// values per individual, and results as a row-major matrix, one row per individual
+// and one column per time.
+class ProportionalHazards
+{
+  pdg::Survival const& baseline_;
+  std::vector<double>  beta_;
+
+public:
+  // Create a model of the specified 'baseline' curve and coefficients 'beta'. The
+  // behaviour is undefined unless 'baseline' outlives this object.
+  ProportionalHazards(pdg::Survival const& baseline, std::vector<double> beta);
+
+  // Return the number of covariates of this model.
+  std::size_t covariates() const noexcept;
+
+  // Return the linear predictor 'beta . x' of an individual whose covariates are in
+  // the array starting at the specified 'x'.
+  double linear_predictor(double const* x) const noexcept;
+
+  // Load the linear predictors of the specified 'individuals', whose covariates are
+  // in the matrix starting at the specified 'x', into the array starting at the
+  // specified 'result'.
+  void linear_predictors(double const* x, std::size_t individuals,
+                         double* result) const noexcept;
+
+  // Load the survival probabilities of the specified 'individuals', whose covariates
+  // are in the matrix starting at the specified 'x', at the specified 'count' times
+  // starting at 'T', into the matrix starting at the specified 'result', using the
+  // specified number of 'threads' (at least one is used). A 'pdg::computation_error'
+  // is thrown if the evaluation of the baseline fails. The behaviour is undefined
+  // unless the times are non-negative, and 'result' can hold
+  // 'individuals * count' values.
+  void survival_prob(double const* x, std::size_t individuals,
+                     pdg::Time const* T, std::size_t count, pdg::Probability* result,
+                     unsigned threads = std::thread::hardware_concurrency()) const;
+
+  // Load the cumulative hazards of the specified 'individuals', whose covariates
+  // are in the matrix starting at the specified 'x', at the specified 'count' times
+  // starting at 'T', into the matrix starting at the specified 'result', using the
+  // specified number of 'threads' (at least one is used). A 'pdg::computation_error'
+  // is thrown if the evaluation of the baseline fails. The behaviour is undefined
+  // unless the times are non-negative, and 'result' can hold
+  // 'individuals * count' values.
+  void cumulative_hazard(double const* x, std::size_t individuals,
+                         pdg::Time const* T, std::size_t count, double* result,
+                         unsigned threads = std::thread::hardware_concurrency()) const;
+
+private:
+  // Load into the specified 'result' the cumulative hazards, or the survival
+  // probabilities if the specified 'survival' is 'true', of the specified
+  // 'individuals' with covariates 'x', given the baseline cumulative hazards 'H_0'
+  // at the specified 'count' times, on the specified number of 'threads'.
+  void fill(double const* x, std::size_t individuals,
+            double const* H_0, std::size_t count, double* result,
+            bool survival, unsigned threads) const;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // max, min
+#include <cassert>
+#include <cmath>     // exp
+#include <utility>   // move
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+namespace pdg::detail {
+
+// Return the dot product of the arrays of the specified 'count' elements starting at
+// the specified 'x' and 'y'. The products are accumulated in independent lanes, an
+// explicit reassociation of the sum, so that the compiler can vectorize the loop
+// without being allowed to reassociate floating point additions itself.
+PDG_INLINE double dot(double const* x, double const* y, std::size_t count) noexcept
+{
+  constexpr std::size_t lanes = 4;
+  double acc[lanes] = {};
+  std::size_t k = 0;
+  for (; k + lanes <= count; k += lanes) {
+    for (std::size_t l = 0; l != lanes; ++l) acc[l] += x[k + l] * y[k + l];
+  }
+  double result = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  for (; k != count; ++k) result += x[k] * y[k];
+  return result;
+}
+
+} // namespace pdg::detail
+
+PDG_INLINE pdg::ProportionalHazards::ProportionalHazards(pdg::Survival const& baseline,
+                                                         std::vector<double> beta)
+: baseline_(baseline)
+, beta_(std::move(beta))
+{ }
+
+PDG_INLINE std::size_t pdg::ProportionalHazards::covariates() const noexcept
+{
+  return beta_.size();
+}
+
+PDG_INLINE double pdg::ProportionalHazards::linear_predictor(double const* x) const noexcept
+{
+  return pdg::detail::dot(beta_.data(), x, beta_.size());
+}
+
+PDG_INLINE void pdg::ProportionalHazards::linear_predictors(double const* x,
+                                                            std::size_t individuals,
+                                                            double* result) const noexcept
+{
+  for (std::size_t i = 0; i != individuals; ++i) {
+    result[i] = linear_predictor(x + i * beta_.size());
+  }
+}
+
+PDG_INLINE void pdg::ProportionalHazards::survival_prob(
+                      double const* x, std::size_t individuals,
+                      pdg::Time const* T, std::size_t count, pdg::Probability* result,
+                      unsigned threads) const
+{
+  std::vector<double> H_0(count);
+  baseline_.cumulative_hazard(T, count, H_0.data());
+  fill(x, individuals, H_0.data(), count, result, true, threads);
+}
+
+PDG_INLINE void pdg::ProportionalHazards::cumulative_hazard(
+                      double const* x, std::size_t individuals,
+                      pdg::Time const* T, std::size_t count, double* result,
+                      unsigned threads) const
+{
+  std::vector<double> H_0(count);
+  baseline_.cumulative_hazard(T, count, H_0.data());
+  fill(x, individuals, H_0.data(), count, result, false, threads);
+}
+
+PDG_INLINE void pdg::ProportionalHazards::fill(double const* x, std::size_t individuals,
+                                               double const* H_0, std::size_t count,
+                                               double* result, bool survival,
+                                               unsigned threads) const
+{
+  // Fill the rows of the individuals in '[first, last)'.
+  auto fill_rows = [this, x, H_0, count, result, survival](std::size_t first,
+                                                          std::size_t last) noexcept {
+    for (std::size_t i = first; i != last; ++i) {
+      auto const risk = std::exp(linear_predictor(x + i * beta_.size()));
+      auto const row  = result + i * count;
+      for (std::size_t j = 0; j != count; ++j) {
+        // '0 * infty' is avoided where the baseline has no hazard yet.
+        auto const H = H_0[j] == 0 ? 0 : risk * H_0[j];
+        row[j] = survival ? std::exp(- H) : H;
+      }
+    }
+  };
+
+  // Rows of at least a few kilobytes are given to each thread, so that the threads
+  // do not share cache lines of the result, and do not cost more than they save.
+  auto const min_rows = std::max<std::size_t>(1, 1024 / std::max<std::size_t>(1, count));
+  auto const workers  = std::max<std::size_t>(1,
+                          std::min<std::size_t>(std::max(threads, 1u), individuals / min_rows));
+  auto const rows = (individuals + workers - 1) / workers;
+
+  std::vector<std::thread> pool;
+  std::size_t first = 0;
+  try {
+    pool.reserve(workers - 1);
+    for (; pool.size() + 1 < workers && first + rows < individuals; first += rows) {
+      pool.emplace_back(fill_rows, first, first + rows);
+    }
+  }
+  catch (...) { // fill the rows not given to a thread on this one.
+  }
+  fill_rows(first, individuals);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // PROPORTIONAL_HAZARDS_HPP_INCLUDE_GUARD
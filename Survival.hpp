@@ -1,6 +1,10 @@
 #ifndef SURVIVAL_HPP_INCLUDE_GUARD
 #define SURVIVAL_HPP_INCLUDE_GUARD
 
+#include <cstddef>
+
+#include "config.hpp"
+
 namespace pdg {
 
 // Convience aliases
@@ -22,6 +26,10 @@ struct computation_error {};
 // probability function 'S', with opposite sign and rescaled by 'S' itself, or
 // 'h(T) = - S'(T) / S(T)' in formulas; note that the the right-derivative of 'S',
 // which is well defined, is used.
+// The cumulative hazard 'H(T) = - log S(T)', the integral of 'h' over '[0,T]', is also
+// available, together with the log-survival probability 'log S(T) = - H(T)'; both are
+// representable where 'S' underflows, and 'H' is the natural quantity of hazard-based
+// curves, so that working with them avoids round trips through 'exp' and 'log'.
 class Survival
 {
   // No data members!
@@ -40,7 +48,8 @@ public:
 
   // Return the probability 'S(T|t)' that this system will survive until at least
   // the specified 'T', conditional to it surviving until at least the specified 't'.
-  // It is equivalent to calling 'survival_prob(T) / survival_prob(t)'.
+  // It is equivalent to calling 'survival_prob(T) / survival_prob(t)', or
+  // 'exp(log_survival_prob(T) - log_survival_prob(t))'.
   // An exception of type 'pdg::computation_error' is thrown if the computation fails;
   // in particular this happens if 'survival_prob(t) == 0'.
   // The behaviour is undefined unless '0 <= t <= T'.
@@ -56,6 +65,30 @@ public:
   // then '+infty' is returned. The behaviour is undefined unless 'T >= 0'.
   double hazard_rate(pdg::Time const& T) const;
 
+  // Return the cumulative hazard 'H(T) = - log S(T)' of this system at the specified
+  // 'T'; see the class description. The result is greater than or equal to '0', and
+  // is '+infty' if 'survival_prob(T) == 0'. A 'pdg::computation_error' is thrown if
+  // the computation fails. The behaviour is undefined unless 'T >= 0'.
+  double cumulative_hazard(pdg::Time const& T) const;
+
+  // Load the cumulative hazards at the specified 'count' times starting at the
+  // specified 'T' into the array starting at the specified 'result', as if by calling
+  // 'cumulative_hazard' for each of them. The behaviour is undefined unless all the
+  // times are non-negative, and 'result' can hold 'count' values.
+  void cumulative_hazard(pdg::Time const* T, std::size_t count, double* result) const;
+
+  // Return the logarithm 'log S(T) = - H(T)' of the probability that this system will
+  // survive until at least the specified 'T', '-infty' if 'survival_prob(T) == 0'.
+  // A 'pdg::computation_error' is thrown if the computation fails. The behaviour is
+  // undefined unless 'T >= 0'.
+  double log_survival_prob(pdg::Time const& T) const;
+
+  // Load the log-survival probabilities at the specified 'count' times starting at the
+  // specified 'T' into the array starting at the specified 'result', as if by calling
+  // 'log_survival_prob' for each of them. The behaviour is undefined unless all the
+  // times are non-negative, and 'result' can hold 'count' values.
+  void log_survival_prob(pdg::Time const* T, std::size_t count, double* result) const;
+
 private:
   // Implement the 'survival_prob' contract.
   virtual pdg::Probability survival_prob_impl(pdg::Time const& T) const = 0;
@@ -65,9 +98,22 @@ protected:
   // Implement the 'conditional_survival_prob' contract. A default implementation
   // calling 'S(T)/S(t)' is supplied, and classes implementing this protocol can
   // opt into it by calling 'Survival::conditional_survival_prob_impl(T, t)' if
-  // they cannot provide a more efficient implementation.
+  // they cannot provide a more efficient implementation. Curves having a closed
+  // form cumulative hazard should rather compute 'exp(H(t) - H(T))', which does
+  // not fail where 'S' underflows.
   virtual pdg::Probability conditional_survival_prob_impl(
                              pdg::Time const& T, pdg::Time const& t) const = 0;
+
+  // Implement the 'cumulative_hazard' contract. The default implementation computes
+  // '- log S(T)' through 'survival_prob'; hazard-based curves should override it with
+  // an exact implementation.
+  virtual double cumulative_hazard_impl(pdg::Time const& T) const;
+
+  // Implement the batched 'cumulative_hazard' contract. The default implementation
+  // calls 'cumulative_hazard_impl' for each time; curves having a vectorizable
+  // closed form may override it.
+  virtual void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                            double* result) const;
 };
 
 } // namespace pdg
@@ -76,16 +122,19 @@ protected:
 // Implementation
 ///////////////////////////////////////////////////////////////////////////////
 #include <cassert>
+#include <cmath> // exp, log, isinf
 
-pdg::Survival::~Survival() noexcept = default;
+#if PDG_DEFINE_NON_TEMPLATES
 
-pdg::Probability pdg::Survival::survival_prob(pdg::Time const& T) const
+PDG_INLINE pdg::Survival::~Survival() noexcept = default;
+
+PDG_INLINE pdg::Probability pdg::Survival::survival_prob(pdg::Time const& T) const
 {
   assert( T >= 0 );
   return survival_prob_impl(T);
 }
 
-pdg::Probability pdg::Survival::conditional_survival_prob(
+PDG_INLINE pdg::Probability pdg::Survival::conditional_survival_prob(
                                 pdg::Time const& T, pdg::Time const& t) const
 {
   assert( 0 <= t      );
@@ -93,13 +142,38 @@ pdg::Probability pdg::Survival::conditional_survival_prob(
   return conditional_survival_prob_impl(T, t);
 }
 
-double pdg::Survival::hazard_rate(pdg::Time const& T) const
+PDG_INLINE double pdg::Survival::hazard_rate(pdg::Time const& T) const
 {
   assert( T >= 0 );
   return hazard_rate_impl(T);
 }
 
-pdg::Probability pdg::Survival::conditional_survival_prob_impl(
+PDG_INLINE double pdg::Survival::cumulative_hazard(pdg::Time const& T) const
+{
+  assert( T >= 0 );
+  return cumulative_hazard_impl(T);
+}
+
+PDG_INLINE void pdg::Survival::cumulative_hazard(pdg::Time const* T, std::size_t count,
+                                                 double* result) const
+{
+  cumulative_hazard_batch_impl(T, count, result);
+}
+
+PDG_INLINE double pdg::Survival::log_survival_prob(pdg::Time const& T) const
+{
+  assert( T >= 0 );
+  return - cumulative_hazard_impl(T);
+}
+
+PDG_INLINE void pdg::Survival::log_survival_prob(pdg::Time const* T, std::size_t count,
+                                                 double* result) const
+{
+  cumulative_hazard_batch_impl(T, count, result);
+  for (std::size_t i = 0; i != count; ++i) result[i] = - result[i];
+}
+
+PDG_INLINE pdg::Probability pdg::Survival::conditional_survival_prob_impl(
                                 pdg::Time const& T, pdg::Time const& t) const
 {
   assert( 0 <= t      );
@@ -109,4 +183,23 @@ pdg::Probability pdg::Survival::conditional_survival_prob_impl(
   return survival_prob(T) / S_t;
 }
 
+PDG_INLINE double pdg::Survival::cumulative_hazard_impl(pdg::Time const& T) const
+{
+  auto const S_T = survival_prob(T);
+  if (!(S_T >= 0)) throw computation_error{};
+  return - std::log(S_T);
+}
+
+PDG_INLINE void pdg::Survival::cumulative_hazard_batch_impl(pdg::Time const* T,
+                                                            std::size_t count,
+                                                            double* result) const
+{
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( T[i] >= 0 );
+    result[i] = cumulative_hazard_impl(T[i]);
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
 #endif // SURVIVAL_HPP_INCLUDE_GUARD
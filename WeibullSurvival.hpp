@@ -0,0 +1,134 @@
+#ifndef WEIBULL_SURVIVAL_HPP_INCLUDE_GUARD
+#define WEIBULL_SURVIVAL_HPP_INCLUDE_GUARD
+
+#include <cstddef>
+
+#include "config.hpp"
+#include "Survival.hpp"
+
+namespace pdg {
+
+// This class implements the 'pdg::Survival' protocol with the Weibull law of shape
+// 'k' and scale 'lambda': 'H(T) = (T / lambda)^k', 'S(T) = exp(-H(T))', and
+// 'h(T) = (k / lambda) (T / lambda)^(k-1)'. The hazard rate is decreasing if 'k < 1',
+// constant if 'k == 1', and increasing if 'k > 1'; if 'k < 1', it is '+infty' at '0'.
+// All the functions, including the inverse of the survival probability, are computed
+// in closed form.
+class WeibullSurvival : public pdg::Survival
+{
+  double shape_;
+  double scale_;
+
+public:
+  // Create a Weibull curve of the specified 'shape' and 'scale'. The behaviour is
+  // undefined unless '0 < shape' and '0 < scale'.
+  WeibullSurvival(double shape, double scale);
+
+  // Return the shape 'k' of this curve.
+  double shape() const noexcept;
+  // Return the scale 'lambda' of this curve.
+  double scale() const noexcept;
+
+  // Return the time 'T' such that 'survival_prob(T) == u' for the specified 'u', so
+  // that failure times are sampled from uniform variates 'u'. '+infty' is returned if
+  // 'u == 0'. The behaviour is undefined unless '0 <= u <= 1'.
+  pdg::Time inverse_survival_prob(pdg::Probability u) const noexcept;
+
+  // Load the inverses of the survival probability at the specified 'count' values
+  // starting at the specified 'u' into the array starting at the specified 'result'.
+  // The behaviour is undefined unless the values are in '[0, 1]'.
+  void inverse_survival_prob(pdg::Probability const* u, std::size_t count,
+                             pdg::Time* result) const noexcept;
+
+private:
+  pdg::Probability survival_prob_impl(pdg::Time const& T) const override;
+  double hazard_rate_impl(pdg::Time const& T) const override;
+  pdg::Probability conditional_survival_prob_impl(
+                          pdg::Time const& T, pdg::Time const& t) const override;
+  double cumulative_hazard_impl(pdg::Time const& T) const override;
+  void cumulative_hazard_batch_impl(pdg::Time const* T, std::size_t count,
+                                    double* result) const override;
+};
+
+} // namespace pdg
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <cassert>
+#include <cmath> // exp, log, pow
+
+#if PDG_DEFINE_NON_TEMPLATES
+
+PDG_INLINE pdg::WeibullSurvival::WeibullSurvival(double shape, double scale)
+: shape_(shape)
+, scale_(scale)
+{
+  assert( 0 < shape );
+  assert( 0 < scale );
+}
+
+PDG_INLINE double pdg::WeibullSurvival::shape() const noexcept
+{
+  return shape_;
+}
+
+PDG_INLINE double pdg::WeibullSurvival::scale() const noexcept
+{
+  return scale_;
+}
+
+PDG_INLINE pdg::Time pdg::WeibullSurvival::inverse_survival_prob(
+                                                   pdg::Probability u) const noexcept
+{
+  assert( 0 <= u && u <= 1 );
+  return scale_ * std::pow(- std::log(u), 1 / shape_);
+}
+
+PDG_INLINE void pdg::WeibullSurvival::inverse_survival_prob(
+                pdg::Probability const* u, std::size_t count, pdg::Time* result) const noexcept
+{
+  auto const scale = scale_, exponent = 1 / shape_;
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( 0 <= u[i] && u[i] <= 1 );
+    result[i] = scale * std::pow(- std::log(u[i]), exponent);
+  }
+}
+
+PDG_INLINE pdg::Probability pdg::WeibullSurvival::survival_prob_impl(
+                                                          pdg::Time const& T) const
+{
+  return std::exp(- cumulative_hazard_impl(T));
+}
+
+PDG_INLINE double pdg::WeibullSurvival::hazard_rate_impl(pdg::Time const& T) const
+{
+  return shape_ / scale_ * std::pow(T / scale_, shape_ - 1);
+}
+
+PDG_INLINE pdg::Probability pdg::WeibullSurvival::conditional_survival_prob_impl(
+                                     pdg::Time const& T, pdg::Time const& t) const
+{
+  return std::exp(cumulative_hazard_impl(t) - cumulative_hazard_impl(T));
+}
+
+PDG_INLINE double pdg::WeibullSurvival::cumulative_hazard_impl(pdg::Time const& T) const
+{
+  return std::pow(T / scale_, shape_);
+}
+
+PDG_INLINE void pdg::WeibullSurvival::cumulative_hazard_batch_impl(
+                  pdg::Time const* T, std::size_t count, double* result) const
+{
+  // Without virtual calls nor branches, the loop can be vectorized by compilers
+  // having vector versions of the mathematical functions.
+  auto const scale = scale_, shape = shape_;
+  for (std::size_t i = 0; i != count; ++i) {
+    assert( T[i] >= 0 );
+    result[i] = std::pow(T[i] / scale, shape);
+  }
+}
+
+#endif // PDG_DEFINE_NON_TEMPLATES
+
+#endif // WEIBULL_SURVIVAL_HPP_INCLUDE_GUARD
@@ -0,0 +1,167 @@
+#ifndef AGGREGATE_HPP_INCLUDE_GUARD
+#define AGGREGATE_HPP_INCLUDE_GUARD
+
+// This file defines generic implementations of the customization points of
+// this library for visitable types (see "is_visitable.hpp"), such as plain
+// aggregates, operating field by field: 'lib::aggregate_printer',
+// 'lib::aggregate_serializer', 'lib::aggregate_equal' and 'lib::aggregate_hash'.
+// Types opt in explicitly, by deriving the customization points from them:
+//..
+//  struct Point { int x; int y; };
+//  template<> struct lib::printer<Point> : lib::aggregate_printer<Point> {};
+//  template<> struct lib::serializer<Point> : lib::aggregate_serializer<Point> {};
+//  template<> struct std::hash<Point> : lib::aggregate_hash<Point> {};
+//  bool operator == (Point const& lhs, Point const& rhs) {
+//    return lib::aggregate_equal<Point>{}(lhs, rhs);
+//  }
+//..
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "is_printable.hpp"
+#include "is_visitable.hpp"
+#include "serializer.hpp"
+
+namespace lib {
+
+// Invokable class that prints visitable objects of type 'T' to 'stdout', as
+// the list of their fields enclosed in braces and separated by commas, e.g.
+// '{1, 2}'. Each field is printed using 'lib::print'.
+template<class T>
+struct aggregate_printer
+{
+  static_assert(ttl::is_visitable_v<T>, "T must be visitable");
+
+  // Print the specified 'obj' to 'stdout'.
+  void operator () (T const& obj);
+};
+
+// Invokable class that encodes visitable objects of type 'T' to, and decodes
+// them from, a buffer of bytes, as the concatenation of the encodings of their
+// fields, using 'lib::serialize' and 'lib::deserialize'. Decoded objects are
+// list-initialized from their fields, so that 'T' need not be default
+// constructible.
+template<class T>
+struct aggregate_serializer
+{
+  static_assert(ttl::is_visitable_v<T>, "T must be visitable");
+
+  // Append the encoding of the specified 'obj' to the specified 'buffer'.
+  void operator () (T const& obj, std::string& buffer);
+
+  // Decode an object from the front of the specified 'buffer', and remove the
+  // consumed bytes from it. A 'lib::serialization_error' is thrown if
+  // 'buffer' is malformed.
+  T operator () (std::string_view& buffer);
+};
+
+// Invokable class that compares visitable objects of type 'T' field by field.
+template<class T>
+struct aggregate_equal
+{
+  static_assert(ttl::is_visitable_v<T>, "T must be visitable");
+
+  // Return 'true' if all the fields of the specified 'lhs' and 'rhs' compare
+  // equal, and 'false' otherwise.
+  bool operator () (T const& lhs, T const& rhs) const;
+};
+
+// Invokable class that hashes visitable objects of type 'T', combining the
+// hashes of their fields computed by 'std::hash'. Objects of bitwise equality
+// comparable types (see "is_trivially_relocatable.hpp") are hashed through
+// their bytes instead.
+template<class T>
+struct aggregate_hash
+{
+  static_assert(ttl::is_visitable_v<T>, "T must be visitable");
+
+  // Return the hash of the specified 'obj'.
+  std::size_t operator () (T const& obj) const;
+};
+
+} // namespace lib
+
+// Implementation /////////////////////////////////////////////////////////////
+#include <functional> // hash
+#include <tuple>
+#include <type_traits>
+#include <utility>    // index_sequence
+#include <fmt/core.h>
+
+#include "is_trivially_relocatable.hpp"
+
+namespace lib::detail {
+
+// Return an object of type 'T' list-initialized from the fields decoded in
+// order from the front of the specified 'buffer', whose types are those of
+// the elements of the tuple 'Tie'. Note that the elements of a braced list are
+// evaluated in order.
+template<class T, class Tie, std::size_t... I>
+T deserialize_fields(std::string_view& buffer, std::index_sequence<I...>)
+{
+  return T{ lib::deserialize<std::remove_cv_t<std::remove_reference_t<
+                               std::tuple_element_t<I, Tie>>>>(buffer)... };
+}
+
+} // namespace lib::detail
+
+template<class T>
+void lib::aggregate_printer<T>::operator () (T const& obj)
+{
+  bool first = true;
+  fmt::print("{{");
+  ttl::visit_fields(obj, [&first](auto const& field) {
+    if (!first) fmt::print(", ");
+    first = false;
+    lib::print(field);
+  });
+  fmt::print("}}");
+}
+
+template<class T>
+void lib::aggregate_serializer<T>::operator () (T const& obj,
+                                                std::string& buffer)
+{
+  ttl::visit_fields(obj, [&buffer](auto const& field) {
+    lib::serialize(field, buffer);
+  });
+}
+
+template<class T>
+T lib::aggregate_serializer<T>::operator () (std::string_view& buffer)
+{
+  using Tie = decltype(ttl::tie_fields(std::declval<T&>()));
+  auto input = buffer;
+  auto result = lib::detail::deserialize_fields<T, Tie>(
+                        input, std::make_index_sequence<std::tuple_size_v<Tie>>{});
+  buffer = input;
+  return result;
+}
+
+template<class T>
+bool lib::aggregate_equal<T>::operator () (T const& lhs, T const& rhs) const
+{
+  return ttl::tie_fields(lhs) == ttl::tie_fields(rhs);
+}
+
+template<class T>
+std::size_t lib::aggregate_hash<T>::operator () (T const& obj) const
+{
+  if constexpr (ttl::is_bitwise_equality_comparable_v<T>) {
+    return std::hash<std::string_view>{}(
+               std::string_view(reinterpret_cast<char const*>(&obj), sizeof(T)));
+  }
+  else {
+    std::size_t seed = 0;
+    ttl::visit_fields(obj, [&seed](auto const& field) {
+      using Field = std::remove_cv_t<std::remove_reference_t<decltype(field)>>;
+      // The combination of 'boost::hash_combine'.
+      seed ^= std::hash<Field>{}(field) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    });
+    return seed;
+  }
+}
+
+#endif // AGGREGATE_HPP_INCLUDE_GUARD
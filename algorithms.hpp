@@ -0,0 +1,130 @@
+#ifndef ALGORITHMS_HPP_INCLUDE_GUARD
+#define ALGORITHMS_HPP_INCLUDE_GUARD
+
+// This file defines algorithms on contiguous ranges of objects, dispatching on
+// type traits to select their implementation: 'ttl::copy_n', 'ttl::relocate_n'
+// and 'ttl::fill_n' copy the bytes of the objects using 'std::memmove',
+// 'std::memcpy' and 'std::memset' when their types allow it, and 'ttl::equal'
+// compares them using 'std::memcmp'. Otherwise, element-wise loops are used,
+// which compilers are free to vectorize. Generic containers are meant to use
+// these algorithms to benefit from the fast paths without further effort.
+// Types opt in the fast paths of 'ttl::relocate_n' and 'ttl::equal' by
+// specializing the traits of "is_trivially_relocatable.hpp".
+
+#include <cstddef>
+
+#include "is_trivially_relocatable.hpp"
+
+namespace ttl { // type traits library
+
+// Copy-assign the specified 'count' objects starting at the specified 'first'
+// to the objects starting at the specified 'result', in order, and return a
+// pointer past the last object assigned. The behaviour is undefined unless
+// 'result' is not in '(first, first + count)'.
+template<class T>
+T* copy_n(T const* first, std::size_t count, T* result);
+
+// Move the specified 'count' objects starting at the specified 'first' to the
+// uninitialized storage starting at the specified 'result', and destroy them,
+// ending their lifetime; return a pointer past the last object created. The
+// behaviour is undefined if the two ranges overlap.
+template<class T>
+T* relocate_n(T* first, std::size_t count, T* result) noexcept;
+
+// Copy-assign the specified 'value' to the specified 'count' objects starting
+// at the specified 'first', and return a pointer past the last object assigned.
+// The behaviour is undefined unless 'value' is not in '[first, first + count)'.
+template<class T>
+T* fill_n(T* first, std::size_t count, T const& value);
+
+// Return 'true' if each of the specified 'count' objects starting at the
+// specified 'first1' compares equal to the object at the same position
+// starting at the specified 'first2', and 'false' otherwise.
+template<class T>
+bool equal(T const* first1, std::size_t count, T const* first2);
+
+} // namespace ttl
+
+// Implementation /////////////////////////////////////////////////////////////
+#include <cstring>     // memcmp, memcpy, memmove, memset
+#include <memory>      // addressof
+#include <new>
+#include <type_traits>
+#include <utility>     // move
+
+namespace ttl::detail {
+
+// Whether the assignment of objects of type 'T' copies their bytes.
+template<class T>
+constexpr bool is_bitwise_assignable_v = std::is_trivially_copyable_v<T>
+                                      && std::is_trivially_copy_assignable_v<T>;
+
+} // namespace ttl::detail
+
+template<class T>
+T* ttl::copy_n(T const* first, std::size_t count, T* result)
+{
+  if constexpr (ttl::detail::is_bitwise_assignable_v<T>) {
+    if (count != 0) std::memmove(result, first, count * sizeof(T));
+    return result + count;
+  }
+  else {
+    for (; count != 0; --count) {
+      *result++ = *first++;
+    }
+    return result;
+  }
+}
+
+template<class T>
+T* ttl::relocate_n(T* first, std::size_t count, T* result) noexcept
+{
+  if constexpr (ttl::is_trivially_relocatable_v<T>) {
+    if (count != 0) std::memcpy(static_cast<void*>(result),
+                                static_cast<void const*>(first), count * sizeof(T));
+    return result + count;
+  }
+  else {
+    static_assert( std::is_nothrow_move_constructible_v<T>,
+                   "T must be nothrow move constructible, to be relocated" );
+    for (; count != 0; --count, ++first, ++result) {
+      ::new (static_cast<void*>(result)) T(std::move(*first));
+      first->~T();
+    }
+    return result;
+  }
+}
+
+template<class T>
+T* ttl::fill_n(T* first, std::size_t count, T const& value)
+{
+  if constexpr (ttl::detail::is_bitwise_assignable_v<T> && sizeof(T) == 1) {
+    if (count != 0) std::memset(first, *reinterpret_cast<unsigned char const*>(
+                                                 std::addressof(value)), count);
+    return first + count;
+  }
+  else {
+    for (; count != 0; --count) {
+      *first++ = value;
+    }
+    return first;
+  }
+}
+
+template<class T>
+bool ttl::equal(T const* first1, std::size_t count, T const* first2)
+{
+  if constexpr (ttl::is_bitwise_equality_comparable_v<T>) {
+    return count == 0 || std::memcmp(static_cast<void const*>(first1),
+                                     static_cast<void const*>(first2),
+                                     count * sizeof(T)) == 0;
+  }
+  else {
+    for (; count != 0; --count) {
+      if (!(*first1++ == *first2++)) return false;
+    }
+    return true;
+  }
+}
+
+#endif // ALGORITHMS_HPP_INCLUDE_GUARD
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark for the headers of this repository.
+
+Generates synthetic translation units instantiating the library components for
+N distinct types, compiles each of them, and reports the compile wall time and
+the peak memory of the compiler. With Clang, '-ftime-trace' is additionally
+used to report the time spent instantiating templates.
+
+The scenarios are:
+  traits   'ttl::is_regular_v' and 'lib::is_printable_v'
+  adapter  'lib::PrintableValueAdapter<T>', created, cloned and printed
+  handle   'lib::Handle<T>' (version 3), created, copied and moved
+  all      all of the above in a single translation unit
+
+Results can be saved as a baseline, and later runs compared against it: the
+script exits with status 1 if a measure regresses by more than the tolerance,
+so that header changes slowing down builds are caught.
+
+Examples:
+  bench/compile_time.py --types 1000 --save baseline.json
+  bench/compile_time.py --types 1000 --compare baseline.json --tolerance 0.1
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+REPO = pathlib.Path(__file__).resolve().parent.parent
+
+SCENARIOS = ("traits", "adapter", "handle", "all")
+
+# Measures compared against the baseline; lower is better for all of them.
+MEASURES = ("wall_s", "peak_rss_mib", "instantiate_s")
+
+
+def generate_types(count):
+    """Return the definitions of 'count' distinct regular, printable types."""
+    lines = ["namespace bench {"]
+    for i in range(count):
+        lines.append(
+            f"struct T{i} {{ int v = {i}; "
+            f"friend bool operator==(T{i} const& a, T{i} const& b) {{ return a.v == b.v; }} "
+            f"friend bool operator!=(T{i} const& a, T{i} const& b) {{ return a.v != b.v; }} }};")
+    lines.append("} // namespace bench")
+    for i in range(count):
+        lines.append(
+            f"template<> struct fmt::formatter<bench::T{i}> : fmt::formatter<int> {{ "
+            f"template<class C> auto format(bench::T{i} const& t, C& ctx) const "
+            f"{{ return fmt::formatter<int>::format(t.v, ctx); }} }};")
+    return lines
+
+
+def generate_tu(scenario, count):
+    """Return the source of the translation unit of 'scenario' for 'count' types."""
+    traits = scenario in ("traits", "all")
+    adapter = scenario in ("adapter", "all")
+    handle = scenario in ("handle", "all")
+
+    lines = ["#include <fmt/core.h>"]
+    if traits:
+        lines += ['#include "is_regular.hpp"', '#include "is_printable.hpp"']
+    if adapter:
+        lines += ['#include "PrintableValueAdapter.hpp"']
+    if handle:
+        lines += ['#include "HandleImpl.v3.h"']
+    lines += generate_types(count)
+
+    lines.append("int bench_main() {")
+    lines.append("  int result = 0;")
+    for i in range(count):
+        t = f"bench::T{i}"
+        if traits:
+            lines.append(f"  static_assert(ttl::is_regular_v<{t}> && lib::is_printable_v<{t}>);")
+        if adapter:
+            lines.append(f"  {{ lib::PrintableValueAdapter<{t}> a({t}{{}}); a.clone()->print(); }}")
+        if handle:
+            lines.append(f"  {{ lib::Handle<{t}> h; auto c = h; h = std::move(c); result += h->v; }}")
+    lines.append("  return result;")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def is_clang(cxx):
+    try:
+        out = subprocess.run([cxx, "--version"], capture_output=True, text=True).stdout
+    except OSError:
+        return False
+    return "clang" in out
+
+
+def instantiation_time(trace_file):
+    """Return the seconds spent instantiating templates, from a Clang trace."""
+    with open(trace_file) as f:
+        events = json.load(f)["traceEvents"]
+    total_us = sum(e.get("dur", 0) for e in events
+                   if e.get("name") in ("Total InstantiateClass",
+                                        "Total InstantiateFunction"))
+    return total_us / 1e6
+
+
+def compile_once(cxx, flags, source, obj, time_trace):
+    """Compile 'source' and return its measures."""
+    command = [cxx, *flags, f"-I{REPO}", "-c", str(source), "-o", str(obj)]
+    if time_trace:
+        command.append("-ftime-trace")
+    start = time.perf_counter()
+    process = subprocess.Popen(command)
+    _, status, usage = os.wait4(process.pid, 0)
+    wall = time.perf_counter() - start
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        sys.exit(f"compilation failed: {' '.join(command)}")
+
+    # 'ru_maxrss' is in kilobytes on Linux, and in bytes on macOS.
+    rss = usage.ru_maxrss * (1 if sys.platform == "darwin" else 1024)
+    measures = {"wall_s": wall, "peak_rss_mib": rss / 2**20}
+    if time_trace:
+        measures["instantiate_s"] = instantiation_time(obj.with_suffix(".json"))
+    return measures
+
+
+def run(args):
+    time_trace = is_clang(args.cxx) if args.time_trace is None else args.time_trace
+    flags = [f"-std={args.std}", *args.cxxflags.split()]
+    results = {"types": args.types, "cxx": args.cxx, "flags": flags, "scenarios": {}}
+
+    with tempfile.TemporaryDirectory(prefix="compile_time_") as tmp:
+        directory = pathlib.Path(args.keep or tmp)
+        directory.mkdir(parents=True, exist_ok=True)
+        for scenario in args.scenarios:
+            source = directory / f"{scenario}.cpp"
+            source.write_text(generate_tu(scenario, args.types))
+            runs = [compile_once(args.cxx, flags, source,
+                                 directory / f"{scenario}.o", time_trace)
+                    for _ in range(args.repeat)]
+            # The median is robust to the noise of a loaded machine.
+            results["scenarios"][scenario] = {
+                m: statistics.median(r[m] for r in runs) for m in runs[0]}
+    return results
+
+
+def report(results, baseline, tolerance):
+    """Print 'results', compared to 'baseline' if any; return the regressions."""
+    regressions = []
+    print(f"{results['types']} types, {results['cxx']} {' '.join(results['flags'])}")
+    for scenario, measures in results["scenarios"].items():
+        cells = []
+        for measure in MEASURES:
+            if measure not in measures:
+                continue
+            value = measures[measure]
+            cell = f"{measure} {value:8.2f}"
+            reference = (baseline or {}).get("scenarios", {}).get(scenario, {}).get(measure)
+            if reference:
+                change = value / reference - 1
+                cell += f" ({change:+6.1%})"
+                if change > tolerance:
+                    regressions.append(f"{scenario}: {measure} {change:+.1%}")
+            cells.append(cell)
+        print(f"  {scenario:8} " + "  ".join(cells))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--types", type=int, default=1000,
+                        help="number of types instantiated (default: 1000)")
+    parser.add_argument("--scenarios", nargs="+", choices=SCENARIOS, default=SCENARIOS)
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="compilations per scenario, the median is kept (default: 3)")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--std", default="c++17")
+    parser.add_argument("--cxxflags", default="-O0",
+                        help="additional compiler flags (default: -O0)")
+    trace = parser.add_mutually_exclusive_group()
+    trace.add_argument("--time-trace", dest="time_trace", action="store_true", default=None,
+                       help="use -ftime-trace (default: with Clang only)")
+    trace.add_argument("--no-time-trace", dest="time_trace", action="store_false")
+    parser.add_argument("--keep", metavar="DIR",
+                        help="keep the generated sources and traces in DIR")
+    parser.add_argument("--save", metavar="FILE", help="save the results to FILE")
+    parser.add_argument("--compare", metavar="FILE",
+                        help="compare the results to the baseline saved in FILE")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="relative regression tolerated by --compare (default: 0.10)")
+    args = parser.parse_args()
+
+    results = run(args)
+    baseline = None
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+        if baseline.get("types") != results["types"]:
+            sys.exit("the baseline was measured for a different number of types")
+    regressions = report(results, baseline, args.tolerance)
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(results, f, indent=2)
+    if regressions:
+        print("regressions:\n  " + "\n  ".join(regressions))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
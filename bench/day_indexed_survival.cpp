@@ -0,0 +1,105 @@
+// day_indexed_survival.cpp
+// Run-time benchmark of 'pdg::DayIndexedSurvival' against the curve it decorates,
+// a 'pdg::PiecewiseHazardSurvival' with monthly knots over 60 years, evaluated
+// by a binary search over its knots. It measures:
+//   build       the construction of the lookup table
+//   whole days  'survival_prob' at random whole days, within the horizon
+//   fractional  'survival_prob' at random fractional times, forwarded to the base
+// for horizons of 1, 10 and 60 years: the table of the longest one does not fit
+// in the L2 cache of most processors.
+// Build and run it from the root of the repository, with optimizations:
+//   c++ -std=c++17 -O2 -DNDEBUG -I. bench/day_indexed_survival.cpp -o day_indexed_survival
+//   ./day_indexed_survival [queries] [repetitions]
+
+#include <algorithm> // sort
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>   // move
+#include <vector>
+
+#include "DayIndexedSurvival.hpp"
+#include "PiecewiseHazardSurvival.hpp"
+
+namespace {
+
+// Return a piecewise constant hazard curve with the specified number of monthly
+// knots.
+pdg::PiecewiseHazardSurvival monthly_curve(std::size_t months)
+{
+  std::vector<pdg::Time> knots;
+  std::vector<double>    hazards;
+  for (std::size_t i = 0; i != months; ++i) {
+    knots.push_back(i / 12.0);
+    hazards.push_back(0.01 + 0.02 * (i % 7) / 7);
+  }
+  return pdg::PiecewiseHazardSurvival(std::move(knots), std::move(hazards));
+}
+
+// Return the median duration, in nanoseconds, of the specified 'repetitions'
+// calls to the specified 'f'.
+template<class F>
+double measure(int repetitions, F f)
+{
+  std::vector<double> durations;
+  for (int i = 0; i < repetitions; ++i) {
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    auto const stop = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size() / 2];
+}
+
+// Return the median duration, in nanoseconds per query, of evaluating the survival
+// probability of the specified 'curve' at the specified 'times'.
+double query(pdg::Survival const& curve, std::vector<pdg::Time> const& times,
+             int repetitions)
+{
+  volatile double sink = 0;
+  auto const total = measure(repetitions, [&] {
+    double sum = 0;
+    for (auto const& T : times) sum += curve.survival_prob(T);
+    sink = sum;
+  });
+  return total / times.size();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::size_t const queries = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  int const repetitions     = argc > 2 ? std::atoi(argv[2]) : 11;
+  std::printf("%zu queries, median of %d repetitions\n", queries, repetitions);
+
+  double const day = 1.0 / 365;
+  auto const base = monthly_curve(60 * 12);
+  std::mt19937_64 random(42);
+
+  for (std::size_t years : {1, 10, 60}) {
+    auto const horizon = static_cast<std::size_t>(years * 365.25);
+    std::uniform_int_distribution<std::size_t> whole(0, horizon);
+    std::uniform_real_distribution<double> fractional(0, horizon * day);
+    std::vector<pdg::Time> whole_days(queries), fractional_times(queries);
+    for (auto& T : whole_days)       T = whole(random) * day;
+    for (auto& T : fractional_times) T = fractional(random);
+
+    auto const build = measure(repetitions, [&] {
+      pdg::DayIndexedSurvival const curve(base, day, horizon);
+    });
+    pdg::DayIndexedSurvival const curve(base, day, horizon);
+
+    std::printf("horizon %2zu years: %6zu days, table %7.1f KiB, build %9.0f ns\n",
+                years, horizon, (horizon + 1) * sizeof(double) / 1024.0, build);
+    std::printf("  whole days  indexed %6.2f ns  base %6.2f ns\n",
+                query(curve, whole_days, repetitions),
+                query(base, whole_days, repetitions));
+    std::printf("  fractional  indexed %6.2f ns  base %6.2f ns\n",
+                query(curve, fractional_times, repetitions),
+                query(base, fractional_times, repetitions));
+  }
+}
@@ -0,0 +1,91 @@
+// default_fill.cpp
+// Run-time benchmark of filling a container with "null" printable values, using
+// 'lib::PrintableValueProtocol::getDefault', which shares 'Default', against a
+// "null" value allocated for each slot, as 'getDefault' used to do. It measures:
+//   fill   creating a vector of 'getDefault()' pointers
+//   clone  cloning each element of such a vector into another one
+// Build and run it from the root of the repository, with optimizations:
+//   c++ -std=c++17 -O2 -DNDEBUG -I. bench/default_fill.cpp -lfmt -o default_fill
+//   ./default_fill [elements] [repetitions]
+
+#include <algorithm> // sort
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <fmt/core.h>
+
+#include "PrintableValueProtocol.hpp"
+
+namespace {
+
+// "Null" value allocated by each clone.
+class AllocatingNull : public lib::PrintableValueProtocol
+{
+  void print_impl() const override {}
+  pointer clone_impl() const override { return std::make_unique<AllocatingNull>(); }
+  type_tag type_tag_impl() const override { return 0; }
+  void serialize_impl(std::string&) const override {}
+  void emit_impl(lib::FieldEmitter&) const override {}
+};
+
+// Return the median duration, in nanoseconds, of the specified 'repetitions'
+// calls to the specified 'f'.
+template<class F>
+double measure(int repetitions, F f)
+{
+  std::vector<double> durations;
+  for (int i = 0; i < repetitions; ++i) {
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    auto const stop = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size() / 2];
+}
+
+using Vector = std::vector<lib::PrintableValueProtocol::pointer>;
+
+// Return a vector of the specified 'count' clones of the specified 'null'.
+Vector fill(lib::PrintableValueProtocol const& null, std::size_t count)
+{
+  Vector result;
+  result.reserve(count);
+  for (std::size_t i = 0; i != count; ++i) result.push_back(null.clone());
+  return result;
+}
+
+// Return a vector of the clones of the elements of the specified 'values'.
+Vector clone(Vector const& values)
+{
+  Vector result;
+  result.reserve(values.size());
+  for (auto const& value : values) result.push_back(value->clone());
+  return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::size_t const count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  int const repetitions   = argc > 2 ? std::atoi(argv[2]) : 11;
+  fmt::print("{} elements, median of {} repetitions\n", count, repetitions);
+
+  AllocatingNull const allocating;
+  auto const& shared = lib::PrintableValueProtocol::Default;
+
+  auto const report = [](char const* benchmark, double shared, double allocating) {
+    fmt::print("  {:6} shared {:12.0f} ns  allocating {:12.0f} ns  ratio {:5.2f}\n",
+               benchmark, shared, allocating, shared / allocating);
+  };
+  report("fill", measure(repetitions, [&] { fill(shared, count); }),
+                 measure(repetitions, [&] { fill(allocating, count); }));
+
+  auto const shared_values     = fill(shared, count);
+  auto const allocating_values = fill(allocating, count);
+  report("clone", measure(repetitions, [&] { clone(shared_values); }),
+                  measure(repetitions, [&] { clone(allocating_values); }));
+}
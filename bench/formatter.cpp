@@ -0,0 +1,109 @@
+// formatter.cpp
+// Run-time benchmark of the fast paths of 'lib::formatter', for arithmetic and
+// string types, against the generic path 'fmt::format_to(std::back_inserter(
+// buffer), "{}", obj)' that 'lib::formatter' uses unless specialized. For each
+// type, it measures appending the representations of many values to a buffer,
+// and checks that both paths produce the same output.
+// Build and run it from the root of the repository, with optimizations:
+//   c++ -std=c++17 -O2 -DNDEBUG -I. bench/formatter.cpp -lfmt -o formatter
+//   ./formatter [elements] [repetitions]
+
+#include <algorithm> // sort
+#include <chrono>
+#include <cmath>     // ldexp
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>  // back_inserter
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fmt/core.h>
+
+#include "is_printable_fmt.hpp"
+
+namespace {
+
+// Return the median duration, in nanoseconds, of the specified 'repetitions'
+// calls to the specified 'f'.
+template<class F>
+double measure(int repetitions, F f)
+{
+  std::vector<double> durations;
+  for (int i = 0; i < repetitions; ++i) {
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    auto const stop = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size() / 2];
+}
+
+// Return the specified 'count' values of type 'T', spread over magnitudes.
+template<class T>
+std::vector<T> make(std::size_t count)
+{
+  std::mt19937_64 random(42);
+  std::vector<T> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i != count; ++i) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      result.push_back(std::string(1 + random() % 32, char('a' + i % 26)));
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+      auto const exponent = static_cast<int>(random() % 40) - 20;
+      result.push_back(static_cast<T>(std::ldexp(double(random() % 1000000), exponent)));
+    }
+    else {
+      result.push_back(static_cast<T>(random() >> (random() % 64)));
+    }
+  }
+  return result;
+}
+
+// Return the representations of the specified 'values', appended to one buffer
+// by 'lib::format_to'.
+template<class T>
+std::string fast(std::vector<T> const& values)
+{
+  std::string buffer;
+  for (auto const& value : values) lib::format_to(value, buffer);
+  return buffer;
+}
+
+// Return the representations of the specified 'values', appended to one buffer
+// by 'fmt::format_to'.
+template<class T>
+std::string generic(std::vector<T> const& values)
+{
+  std::string buffer;
+  for (auto const& value : values) fmt::format_to(std::back_inserter(buffer), "{}", value);
+  return buffer;
+}
+
+template<class T>
+void run(char const* type, std::size_t count, int repetitions)
+{
+  auto const values = make<T>(count);
+  auto const same = fast(values) == generic(values);
+  auto const f = measure(repetitions, [&values] { fast(values); });
+  auto const g = measure(repetitions, [&values] { generic(values); });
+  fmt::print("  {:12} fast path {:12.0f} ns  fmt::format_to {:12.0f} ns  ratio {:5.2f}{}\n",
+             type, f, g, f / g, same ? "" : "  (OUTPUTS DIFFER)");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::size_t const count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  int const repetitions   = argc > 2 ? std::atoi(argv[2]) : 11;
+  fmt::print("{} elements, median of {} repetitions\n", count, repetitions);
+
+  run<int>("int", count, repetitions);
+  run<unsigned long>("unsigned long", count, repetitions);
+  run<float>("float", count, repetitions);
+  run<double>("double", count, repetitions);
+  run<std::string>("std::string", count, repetitions);
+}
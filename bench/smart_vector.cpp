@@ -0,0 +1,178 @@
+// smart_vector.cpp
+// Run-time benchmark of 'ttl::smart_vector' against 'std::vector', for
+// elements of each storage strategy:
+//   int                             small buffer
+//   lib::Handle<Body>               realloc-based growth, or move-based growth
+//                                   if the body is not trivially relocatable
+//   std::string                     move-based growth
+//   lib::PrintableValueAdapter<int> move-based growth
+// For each element type, it measures appending elements one by one without
+// reserving, copying the resulting vector, and creating many short vectors.
+// The traits of "is_trivially_relocatable.hpp" these strategies rely on are
+// checked at compile time for the types of this repository.
+// Build and run it from the root of the repository, with optimizations:
+//   c++ -std=c++17 -O2 -DNDEBUG -I. bench/smart_vector.cpp -lfmt -o smart_vector
+//   ./smart_vector [elements] [repetitions]
+
+#include <algorithm> // sort
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>    // unique_ptr
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fmt/core.h>
+
+#include "HandleImpl.v3.h"
+#include "PrintableValueAdapter.hpp"
+#include "smart_vector.hpp"
+
+namespace {
+
+// Body stored in-place by 'lib::Handle', and trivially relocatable.
+struct SmallBody { int value[4] = {}; };
+
+// Body stored in-place by 'lib::Handle', and not trivially relocatable.
+struct StringBody { std::string value = "a string too long for the small buffer"; };
+
+// Body allocated dynamically by 'lib::Handle'.
+struct LargeBody { std::string value[4]; };
+
+// The storage strategies above rely on the traits of "is_trivially_relocatable.hpp".
+static_assert(  ttl::is_trivially_relocatable_v<int> );
+static_assert(  ttl::is_trivially_relocatable_v<SmallBody> );
+static_assert(  ttl::is_trivially_relocatable_v<lib::Handle<SmallBody>> );
+static_assert( !ttl::is_trivially_relocatable_v<lib::Handle<StringBody>> );
+static_assert(  ttl::is_trivially_relocatable_v<lib::Handle<LargeBody>> );
+static_assert(  ttl::is_trivially_relocatable_v<std::unique_ptr<StringBody>> );
+static_assert(  ttl::is_trivially_relocatable_v<lib::PrintableValueProtocol::pointer> );
+static_assert( !ttl::is_trivially_relocatable_v<std::string> );
+static_assert( !ttl::is_trivially_relocatable_v<lib::PrintableValueAdapter<int>> );
+
+static_assert(  ttl::is_bitwise_equality_comparable_v<int> );
+static_assert(  ttl::is_bitwise_equality_comparable_v<int const*> );
+static_assert( !ttl::is_bitwise_equality_comparable_v<double> );
+static_assert( !ttl::is_bitwise_equality_comparable_v<SmallBody> );
+static_assert( !ttl::is_bitwise_equality_comparable_v<std::string> );
+static_assert( !ttl::is_bitwise_equality_comparable_v<lib::Handle<SmallBody>> );
+
+template<class T>
+T make(std::size_t i)
+{
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(32, char('a' + i % 26));
+  }
+  else if constexpr (std::is_same_v<T, int>) {
+    return int(i);
+  }
+  else if constexpr (std::is_same_v<T, lib::PrintableValueAdapter<int>>) {
+    return lib::PrintableValueAdapter<int>(int(i));
+  }
+  else {
+    return T{};
+  }
+}
+
+// Return the median duration, in nanoseconds, of the specified 'repetitions'
+// calls to the specified 'f'.
+template<class F>
+double measure(int repetitions, F f)
+{
+  std::vector<double> durations;
+  for (int i = 0; i < repetitions; ++i) {
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    auto const stop = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size() / 2];
+}
+
+// Prevent the compiler from optimizing away the computation of 'value'.
+template<class T>
+void keep(T const& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+template<class Vector>
+double append(std::size_t count, int repetitions)
+{
+  using T = typename Vector::value_type;
+  return measure(repetitions, [count] {
+    Vector v;
+    for (std::size_t i = 0; i < count; ++i) v.push_back(make<T>(i));
+    keep(v);
+  });
+}
+
+template<class Vector>
+double copy(std::size_t count, int repetitions)
+{
+  using T = typename Vector::value_type;
+  Vector v;
+  for (std::size_t i = 0; i < count; ++i) v.push_back(make<T>(i));
+  return measure(repetitions, [&v] {
+    Vector c = v;
+    keep(c);
+  });
+}
+
+template<class Vector>
+double short_vectors(std::size_t count, int repetitions)
+{
+  using T = typename Vector::value_type;
+  return measure(repetitions, [count] {
+    for (std::size_t i = 0; i < count / 8; ++i) {
+      Vector v;
+      for (std::size_t j = 0; j < 8; ++j) v.push_back(make<T>(j));
+      keep(v);
+    }
+  });
+}
+
+char const* name(ttl::vector_layout layout)
+{
+  switch (layout) {
+    case ttl::vector_layout::small_buffer: return "small buffer";
+    case ttl::vector_layout::reallocating: return "reallocating";
+    case ttl::vector_layout::moving:       return "moving";
+  }
+  return "";
+}
+
+template<class T>
+void run(char const* type, std::size_t count, int repetitions)
+{
+  using Smart = ttl::smart_vector<T>;
+  using Std   = std::vector<T>;
+  fmt::print("{} ({})\n", type, name(Smart::layout));
+
+  auto const report = [](char const* benchmark, double smart, double std) {
+    fmt::print("  {:14} smart_vector {:12.0f} ns  std::vector {:12.0f} ns  ratio {:5.2f}\n",
+               benchmark, smart, std, smart / std);
+  };
+  report("append", append<Smart>(count, repetitions), append<Std>(count, repetitions));
+  if constexpr (std::is_copy_constructible_v<T>) {
+    report("copy", copy<Smart>(count, repetitions), copy<Std>(count, repetitions));
+  }
+  report("short vectors", short_vectors<Smart>(count, repetitions),
+                          short_vectors<Std>(count, repetitions));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::size_t const count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  int const repetitions   = argc > 2 ? std::atoi(argv[2]) : 11;
+  fmt::print("{} elements, median of {} repetitions\n", count, repetitions);
+
+  run<int>("int", count, repetitions);
+  run<lib::Handle<SmallBody>>("lib::Handle<SmallBody>", count, repetitions);
+  run<lib::Handle<StringBody>>("lib::Handle<StringBody>", count, repetitions);
+  run<std::string>("std::string", count, repetitions);
+  run<lib::PrintableValueAdapter<int>>("lib::PrintableValueAdapter<int>", count, repetitions);
+}
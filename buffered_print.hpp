@@ -0,0 +1,196 @@
+#ifndef BUFFERED_PRINT_HPP_INCLUDE_GUARD
+#define BUFFERED_PRINT_HPP_INCLUDE_GUARD
+
+// This file defines 'lib::buffered_print', an alternative to 'lib::print' for
+// programs printing from many threads at once. Instead of contending on the
+// lock of 'stdout', each thread formats into a buffer of its own, which is
+// written to the standard output file descriptor in large chunks made of whole
+// lines. Chunks are written one at a time, under a process-wide mutex taken
+// once per chunk, so that lines printed by different threads are never
+// interleaved, even when a chunk exceeds 'PIPE_BUF' or is partially written.
+// 'lib::flush_buffered_output' acts as a global barrier, writing the complete
+// lines buffered by all threads. Each buffer is entirely written when its
+// thread exits. Note that output printed through 'stdout' is not ordered with
+// respect to buffered output, except at barriers, which flush 'stdout' first.
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+#include "is_printable_fmt.hpp"
+
+namespace lib {
+
+// Print the specified 'obj' to the standard output through the buffer of the
+// calling thread, as if by calling 'lib::format_to(obj, buffer)'; 'T' must
+// model 'lib::formattable'.
+// The complete lines in the buffer are written once it exceeds
+// 'lib::buffered_output_capacity' bytes. A 'std::system_error' is thrown if
+// writing fails.
+template<typename T>
+void buffered_print(T const& obj);
+
+// Write the complete lines buffered by all threads to the standard output,
+// after flushing 'stdout'. A 'std::system_error' is thrown if writing fails.
+void flush_buffered_output();
+
+// Size above which the buffer of a thread is written.
+inline constexpr std::size_t buffered_output_capacity = std::size_t{64} << 10;
+
+namespace detail {
+// The buffers must be shared by all translation units: the implementation
+// cannot live in an unnamed namespace.
+
+// This class provides the output buffer of a thread. The buffer is guarded by
+// a mutex, which is only contended during a 'lib::flush_buffered_output'.
+class OutputBuffer
+{
+  std::mutex  mutex_;
+  std::string data_;
+public:
+  // Create an empty buffer, registering it for 'lib::flush_buffered_output'.
+  OutputBuffer();
+  // Write the whole buffer, ignoring errors, and unregister it.
+  ~OutputBuffer() noexcept;
+
+  OutputBuffer(OutputBuffer const&) = delete;
+  OutputBuffer& operator = (OutputBuffer const&) = delete;
+
+  // Append the representation of the specified 'obj' to this buffer, and
+  // write its complete lines if it exceeds 'lib::buffered_output_capacity'.
+  template<typename T>
+  void append(T const& obj);
+
+  // Write the complete lines in this buffer.
+  void flush_lines();
+
+private:
+  // Write the complete lines in this buffer. The behaviour is undefined
+  // unless 'mutex_' is locked.
+  void flush_lines_locked();
+};
+
+// Return the output buffer of the calling thread.
+OutputBuffer& thread_output_buffer();
+
+} // namespace detail
+} // namespace lib
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm> // find
+#include <cerrno>
+#include <cstdio>    // fflush
+#include <system_error>
+#include <vector>
+#include <unistd.h>  // write
+
+namespace lib::detail {
+
+// Return the registry of all output buffers, together with its mutex.
+inline std::vector<OutputBuffer*>& output_buffers() {
+  static std::vector<OutputBuffer*> buffers;
+  return buffers;
+}
+
+inline std::mutex& output_buffers_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Return the mutex serializing the writes of the output buffers.
+inline std::mutex& output_write_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Write the specified 'size' bytes at the specified 'data' to the standard
+// output, as one uninterrupted sequence of bytes with respect to the other
+// calls. Return '0' on success, and the error number otherwise.
+inline int write_output(char const* data, std::size_t size) noexcept
+{
+  // A single 'write' is only atomic up to 'PIPE_BUF' bytes, and the rest of a
+  // partial write is written by another call.
+  std::lock_guard<std::mutex> lock(output_write_mutex());
+  while (size != 0) {
+    auto const written = ::write(STDOUT_FILENO, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return errno;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return 0;
+}
+
+inline OutputBuffer::OutputBuffer()
+{
+  std::lock_guard<std::mutex> lock(output_buffers_mutex());
+  output_buffers().push_back(this);
+}
+
+inline OutputBuffer::~OutputBuffer() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(output_buffers_mutex());
+    auto& buffers = output_buffers();
+    buffers.erase(std::find(buffers.begin(), buffers.end(), this));
+  }
+  write_output(data_.data(), data_.size());
+}
+
+template<typename T>
+void OutputBuffer::append(T const& obj)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  lib::format_to(obj, data_);
+  if (data_.size() > lib::buffered_output_capacity) {
+    flush_lines_locked();
+  }
+}
+
+inline void OutputBuffer::flush_lines()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  flush_lines_locked();
+}
+
+inline void OutputBuffer::flush_lines_locked()
+{
+  auto const last_newline = data_.rfind('\n');
+  if (last_newline == std::string::npos) return;
+  auto const size = last_newline + 1;
+  auto const error = write_output(data_.data(), size);
+  data_.erase(0, size);
+  if (error != 0) {
+    throw std::system_error(error, std::generic_category(), "write");
+  }
+}
+
+inline OutputBuffer& thread_output_buffer()
+{
+  thread_local OutputBuffer buffer;
+  return buffer;
+}
+
+} // namespace lib::detail
+
+template<typename T>
+void lib::buffered_print(T const& obj)
+{
+  static_assert( lib::is_formattable_v<T>, "T must be formattable");
+  lib::detail::thread_output_buffer().append(obj);
+}
+
+inline void lib::flush_buffered_output()
+{
+  std::fflush(stdout);
+  std::lock_guard<std::mutex> lock(lib::detail::output_buffers_mutex());
+  for (auto* buffer : lib::detail::output_buffers()) {
+    buffer->flush_lines();
+  }
+}
+
+#endif // BUFFERED_PRINT_HPP_INCLUDE_GUARD
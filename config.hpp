@@ -0,0 +1,34 @@
+#ifndef CONFIG_HPP_INCLUDE_GUARD
+#define CONFIG_HPP_INCLUDE_GUARD
+
+// This file defines the macros selecting how the non-template functions and
+// objects defined by the headers of this library are compiled.
+// By default, the library is header-only: they are defined 'inline' in the
+// headers, which can thus be included in any number of translation units.
+// If 'PDG_COMPILED_LIBRARY' is defined, the headers only declare them: they
+// are defined once, in the library compiled from the sources in 'src/', which
+// define 'PDG_LIBRARY_SOURCE' before including the headers. In that mode, the
+// headers also declare the explicit instantiations of templates compiled in
+// the library, such as 'lib::PrintableValueAdapter<int>'. The same mode must
+// be used by all the translation units of a program.
+
+#if defined(PDG_LIBRARY_SOURCE) && !defined(PDG_COMPILED_LIBRARY)
+#define PDG_COMPILED_LIBRARY
+#endif
+
+// Whether the non-template definitions are to be compiled in this translation
+// unit: always in header-only mode, and only by the library sources otherwise.
+#if !defined(PDG_COMPILED_LIBRARY) || defined(PDG_LIBRARY_SOURCE)
+#define PDG_DEFINE_NON_TEMPLATES 1
+#else
+#define PDG_DEFINE_NON_TEMPLATES 0
+#endif
+
+// Specifier of the non-template functions and variables defined by the headers.
+#if defined(PDG_COMPILED_LIBRARY)
+#define PDG_INLINE
+#else
+#define PDG_INLINE inline
+#endif
+
+#endif // CONFIG_HPP_INCLUDE_GUARD
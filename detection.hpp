@@ -0,0 +1,39 @@
+#ifndef DETECTION_HPP_INCLUDE_GUARD
+#define DETECTION_HPP_INCLUDE_GUARD
+
+// This file defines the detection idiom used to implement the type traits of
+// the 'ttl' library and the concepts of the 'lib' library: whether an
+// expression, given as an alias template, is valid for a type, and whether it
+// has a given type. It lives in a named namespace, rather than an unnamed one,
+// so that all the headers and translation units share the same instantiations.
+
+#include <type_traits>
+
+namespace ttl::detail {
+
+// Detection idiom
+template<template<class> class expression, class T, class = void>
+struct detector : std::false_type {};
+
+template<template<class> class expression, class T>
+struct detector< expression, T, std::void_t< expression<T> > >
+: std::true_type {};
+
+// Whether 'expression<T>' is valid.
+template<template<class> class expression, class T>
+using is_detected = detector<expression, T>;
+
+template<template<class> class expression, class T, class R, class = void>
+struct type_detector : std::false_type {};
+
+template<template<class> class expression, class T, class R>
+struct type_detector< expression, T, R, std::void_t< expression<T> > >
+: std::is_same<expression<T>, R> {};
+
+// Whether 'expression<T>' is valid and is the type 'R'.
+template<template<class> class expression, class T, class R>
+using is_detected_type = type_detector<expression, T, R>;
+
+} // namespace ttl::detail
+
+#endif // DETECTION_HPP_INCLUDE_GUARD
@@ -1,61 +1,19 @@
 #ifndef IS_PRINTABLE_HPP_INCLUDE_GUARD
 #define IS_PRINTABLE_HPP_INCLUDE_GUARD
 
-// This file defines a type trait, 'ttl::is_regular', based on the C++20
-// 'regular' concept. It additionally provide related type traits used
-// to implement 'ttl::is_regular', such as 'ttl::is_copyable' and
-// 'ttl::is_equality_comparable'.
-// It also provides a 'lib::printable' concept, modeled by semiregular types
+// This file defines a 'lib::printable' concept, modeled by semiregular types
 // having value semantics, that can be printed to 'stdout' using 'lib::print'
 // (defined below).
+// It also provides 'lib::printable_ref', a non-owning reference to any
+// printable object, cheap enough to be passed by value.
 // Note that this is a simplified implementation, not fully conformant.
 
+#include <iterator> // back_inserter
+#include <string>
 #include <type_traits>
 #include <fmt/core.h>
 
-namespace ttl { // type traits library
-
-// Movable
-template<class T>
-using is_movable = std::conjunction < std::is_object<T>
-                                    , std::is_move_constructible<T>
-                                    , std::is_assignable<T&, T>
-                                    , std::is_swappable<T> >;
-// Copyable
-template<class T>
-using is_copyable = std::conjunction < ttl::is_movable<T>
-                                     , std::is_copy_constructible<T>
-                                     , std::is_assignable<T&, T const&>
-                                     , std::is_assignable<T&, T&>
-                                     , std::is_assignable<T&, T> >;
-// Semiregular
-template<class T>
-using is_semiregular = std::conjunction < ttl::is_copyable<T>
-                                        , std::is_default_constructible<T> >;
-
-// Equality Comparable
-template<class T>
-struct is_equality_comparable; // Implemented below
-
-// Regular
-template<class T>
-using is_regular = std::conjunction < ttl::is_semiregular<T>
-                                    , ttl::is_equality_comparable<T> >;
-
-// Helper types and variables
-template<class T> using is_movable_t             = typename is_movable<T>::type;
-template<class T> using is_copyable_t            = typename is_copyable<T>::type;
-template<class T> using is_semiregular_t         = typename is_semiregular<T>::type;
-template<class T> using is_equality_comparable_t = typename is_equality_comparable<T>::type;
-template<class T> using is_regular_t             = typename is_regular<T>::type;
-
-template<class T> constexpr bool is_movable_v             =  is_movable<T>::value;
-template<class T> constexpr bool is_copyable_v            =  is_copyable<T>::value;
-template<class T> constexpr bool is_semiregular_v         =  is_semiregular<T>::value;
-template<class T> constexpr bool is_equality_comparable_v =  is_equality_comparable<T>::value;
-template<class T> constexpr bool is_regular_v             =  is_regular<T>::value;
-
-} // namespace ttl
+#include "is_regular.hpp"
 
 namespace lib {
 
@@ -69,6 +27,12 @@ struct printer // class template to support partial specialization
   void operator () (T const& obj) {
     fmt::print("{}", obj);
   }
+
+  // Append the output of the specified 'obj', as printed to 'stdout', to the
+  // specified 'buffer'. Specializations are not required to provide it.
+  void operator () (T const& obj, std::string& buffer) {
+    fmt::format_to(std::back_inserter(buffer), "{}", obj);
+  }
 };
 
 // Print the specified 'obj' to 'stdout', as if by calling 'lib::printer<T>{}(obj)'.
@@ -84,53 +48,60 @@ struct is_printable; // Implemented below
 template<class T> using is_printable_t = typename is_printable<T>::type;
 template<class T> constexpr bool is_printable_v =  is_printable<T>::value;
 
-} // namespace lib
-
-// Implementation /////////////////////////////////////////////////////////////
-
-namespace {
-
-// Detection idiom
-template<template<class> class expression, class T, class = void>
-struct detector : std::false_type {};
-
-template<template<class> class expression, class T>
-struct detector< expression, T, std::void_t< expression<T> > >
-: std::true_type {};
-
-template<template<class> class expression, class T>
-using is_detected = detector<expression, T>;
-
-template<template<class> class expression, class T, class R, class = void>
-struct type_detector : std::false_type {};
+// This class provides a non-owning, type-erased reference to a printable
+// object: it is made of a pointer to the object and a pointer to a function
+// printing it, so that it can be passed by value without allocating or copying
+// the object. The behaviour is undefined if the object referred to is used
+// through a 'printable_ref' after the end of its lifetime.
+class printable_ref
+{
+  void const* obj_;                  // object referred to.
+  void      (*print_)(void const*);  // function printing 'obj_'.
+public:
+  // Create a reference to the specified printable 'obj'.
+  template<class T, class = std::enable_if_t< lib::is_printable_v<T> > >
+  /*implicit*/ printable_ref(T const& obj) noexcept;
+
+  // Print the object referred to by this object to 'stdout', as if by
+  // calling 'lib::print' on it.
+  void print() const;
+};
 
-template<template<class> class expression, class T, class R>
-struct type_detector< expression, T, R, std::void_t< expression<T> > >
-: std::is_same<expression<T>, R> {};
+// Print the object referred to by a 'lib::printable_ref'.
+template<>
+struct printer<printable_ref>
+{
+  // Print the object referred to by the specified 'ref' to 'stdout'.
+  void operator () (printable_ref const& ref) {
+    ref.print();
+  }
+};
 
-template<template<class> class expression, class T, class R>
-using is_detected_type = type_detector<expression, T, R>;
+} // namespace lib
 
-// Expressions for equality comparison
+// Implementation /////////////////////////////////////////////////////////////
 
-template<class T>
-using equality_compare_t   = decltype(std::declval<T const&>() == std::declval<T const&>());
-template<class T>
-using inequality_compare_t = decltype(std::declval<T const&>() != std::declval<T const&>());
+namespace lib::detail {
 
 template<class T>
-using lib_print_t = decltype(lib::print(std::declval<T const&>()));
+using print_t = decltype(lib::print(std::declval<T const&>()));
 
-} // unnamed namespace
-
-template<class T>
-struct ttl::is_equality_comparable
-: std::conjunction < ::is_detected_type<equality_compare_t, T, bool>
-                   , ::is_detected_type<inequality_compare_t, T, bool> > {};
+} // namespace lib::detail
 
 template<class T>
 struct lib::is_printable
 : std::conjunction < ttl::is_semiregular<T>
-                   , ::is_detected_type<lib_print_t, T, void> > {};
+                   , ttl::detail::is_detected_type<lib::detail::print_t, T, void> > {};
+
+template<class T, class>
+lib::printable_ref::printable_ref(T const& obj) noexcept
+: obj_(&obj)
+, print_([](void const* obj) { lib::print(*static_cast<T const*>(obj)); })
+{ }
+
+inline void lib::printable_ref::print() const
+{
+  print_(obj_);
+}
 
 #endif // IS_PRINTABLE_HPP_INCLUDE_GUARD
@@ -1,143 +1,222 @@
 #ifndef IS_PRINTABLE_FMT_HPP_INCLUDE_GUARD
 #define IS_PRINTABLE_FMT_HPP_INCLUDE_GUARD
 
-// This file defines a type trait, 'ttl::is_regular', based on the C++20
-// 'regular' concept. It additionally provide related type traits used
-// to implement 'ttl::is_regular', such as 'ttl::is_copyable' and
-// 'ttl::is_equality_comparable'.
-// It also provides a 'lib::printable' concept, modeled by semiregular types
-// having value semantics, that can be printed to 'stdout' using 'lib::print'
-// (defined below).
-// Note that this is a simplified implementation, not fully conformant.
+// This file defines 'lib::formatter', a customization point formatting objects
+// into strings, together with 'lib::format' and 'lib::format_to' built on it.
+// Arithmetic and string types are formatted by built-in fast paths, which
+// produce the same output as 'fmt::format("{}", obj)'.
+// The 'lib::printable' concept and 'lib::print' are those of "is_printable.hpp",
+// so that both headers can be included together. Note that, unlike in earlier
+// versions of this header, 'lib::print' does not use 'lib::formatter': it calls
+// 'lib::printer<T>', whose default prints 'fmt::print("{}", obj)'. Specializing
+// 'lib::formatter<T>' changes the output of 'lib::format' but not that of
+// 'lib::print', for which 'lib::printer<T>' must be specialized as well; types
+// that 'fmt' cannot format must specialize both.
 
 #include <type_traits>
+#include <iterator> // back_inserter
 #include <string>
+#include <string_view>
 #include <fmt/core.h>
 
-namespace ttl { // type traits library
-
-// Movable
-template<class T>
-using is_movable = std::conjunction < std::is_object<T>
-                                    , std::is_move_constructible<T>
-                                    , std::is_assignable<T&, T>
-                                    , std::is_swappable<T> >;
-// Copyable
-template<class T>
-using is_copyable = std::conjunction < ttl::is_movable<T>
-                                     , std::is_copy_constructible<T>
-                                     , std::is_assignable<T&, T const&>
-                                     , std::is_assignable<T&, T&>
-                                     , std::is_assignable<T&, T> >;
-// Semiregular
-template<class T>
-using is_semiregular = std::conjunction < ttl::is_copyable<T>
-                                        , std::is_default_constructible<T> >;
-
-// Equality Comparable
-template<class T>
-struct is_equality_comparable; // Implemented below
-
-// Regular
-template<class T>
-using is_regular = std::conjunction < ttl::is_semiregular<T>
-                                    , ttl::is_equality_comparable<T> >;
-
-// Helper types and variables
-template<class T> using is_movable_t             = typename is_movable<T>::type;
-template<class T> using is_copyable_t            = typename is_copyable<T>::type;
-template<class T> using is_semiregular_t         = typename is_semiregular<T>::type;
-template<class T> using is_equality_comparable_t = typename is_equality_comparable<T>::type;
-template<class T> using is_regular_t             = typename is_regular<T>::type;
-
-template<class T> constexpr bool is_movable_v             =  is_movable<T>::value;
-template<class T> constexpr bool is_copyable_v            =  is_copyable<T>::value;
-template<class T> constexpr bool is_semiregular_v         =  is_semiregular<T>::value;
-template<class T> constexpr bool is_equality_comparable_v =  is_equality_comparable<T>::value;
-template<class T> constexpr bool is_regular_v             =  is_regular<T>::value;
-
-} // namespace ttl
+#include "is_printable.hpp"
 
 namespace lib {
 
 // Invokable class that prints objects of type 'T' to 'stdout'.
 // This class is a customization point, clients are free to specialize it as needed.
+// Unless specialized, it is only available if 'fmt' can format 'T'.
 template<typename T>
 struct formatter // class template to support partial specialization
 {
   // Print the specified 'obj' to 'stdout'.
   // Unless specialized, call 'fmt::format({}, obj)'.
+  template<class U = T, class = std::enable_if_t< fmt::is_formattable<U>::value > >
   std::string operator () (T const& obj) {
     return fmt::format("{}", obj);
   }
+
+  // Append the representation of the specified 'obj' to the specified 'buffer'.
+  // Unless specialized, call 'fmt::format_to(std::back_inserter(buffer), {}, obj)'.
+  template<class U = T, class = std::enable_if_t< fmt::is_formattable<U>::value > >
+  void operator () (T const& obj, std::string& buffer) {
+    fmt::format_to(std::back_inserter(buffer), "{}", obj);
+  }
+};
+
+// Invokable class that formats arithmetic objects of type 'T' using
+// 'std::to_chars', with the same output as 'fmt::format({}, obj)': integers
+// in base 10, floating point numbers using their shortest representation that
+// round-trips, in fixed notation if their exponent is in '[-4, 16)' and in
+// scientific notation otherwise.
+template<typename T>
+struct to_chars_formatter
+{
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+  // Return the representation of the specified 'obj'.
+  std::string operator () (T const& obj);
+  // Append the representation of the specified 'obj' to the specified 'buffer'.
+  void operator () (T const& obj, std::string& buffer);
+};
+
+// Invokable class that formats string-like objects of type 'T', that is
+// convertible to 'std::string_view', by copying their characters.
+template<typename T>
+struct string_formatter
+{
+  // Return a copy of the characters of the specified 'obj'.
+  std::string operator () (T const& obj) {
+    return std::string(std::string_view(obj));
+  }
+  // Append the characters of the specified 'obj' to the specified 'buffer'.
+  void operator () (T const& obj, std::string& buffer) {
+    buffer.append(std::string_view(obj));
+  }
 };
 
+// Fast paths for arithmetic and string types.
+template<> struct formatter<short>              : to_chars_formatter<short> {};
+template<> struct formatter<unsigned short>     : to_chars_formatter<unsigned short> {};
+template<> struct formatter<int>                : to_chars_formatter<int> {};
+template<> struct formatter<unsigned int>       : to_chars_formatter<unsigned int> {};
+template<> struct formatter<long>               : to_chars_formatter<long> {};
+template<> struct formatter<unsigned long>      : to_chars_formatter<unsigned long> {};
+template<> struct formatter<long long>          : to_chars_formatter<long long> {};
+template<> struct formatter<unsigned long long> : to_chars_formatter<unsigned long long> {};
+template<> struct formatter<float>              : to_chars_formatter<float> {};
+template<> struct formatter<double>             : to_chars_formatter<double> {};
+template<> struct formatter<std::string>        : string_formatter<std::string> {};
+template<> struct formatter<std::string_view>   : string_formatter<std::string_view> {};
+template<> struct formatter<char const*>        : string_formatter<char const*> {};
+
 // Return a representation of 'obj' as a formatted string.
 template<typename T>
 std::string format(T const& obj) {
   return lib::formatter<T>{}(obj);
 }
 
-// Print the specified 'obj' to 'stdout'.
+// Append a representation of the specified 'obj' to the specified 'buffer',
+// as if by 'buffer += lib::format(obj)'. If 'lib::formatter<T>' supports it,
+// the representation is written directly into 'buffer'.
 template<typename T>
-void print(T const& obj) {
-  fmt::print("{}", lib::format(obj));
-}
+void format_to(T const& obj, std::string& buffer); // Implemented below
 
-// 'lib::printable' concept
+// 'lib::formattable' concept, modeled by types that can be formatted using
+// 'lib::format', that is either 'fmt' can format them or 'lib::formatter' is
+// specialized for them. Note that it differs from 'lib::printable': functions
+// writing the output of 'lib::format', such as 'lib::format_to', require it.
 template<class T>
-struct is_printable; // Implemented below
+struct is_formattable; // Implemented below
 
-template<class T> using is_printable_t = typename is_printable<T>::type;
-template<class T> constexpr bool is_printable_v =  is_printable<T>::value;
+template<class T> using is_formattable_t = typename is_formattable<T>::type;
+template<class T> constexpr bool is_formattable_v =  is_formattable<T>::value;
 
 } // namespace lib
 
 // Implementation /////////////////////////////////////////////////////////////
+#include <algorithm> // copy, fill_n, min
+#include <charconv>  // to_chars, from_chars
+#include <cstdint>
+#include <cstring>   // memchr
+#include <limits>
 
-namespace {
-
-// Detection idiom
-template<template<class> class expression, class T, class = void>
-struct detector : std::false_type {};
+namespace lib::detail {
 
-template<template<class> class expression, class T>
-struct detector< expression, T, std::void_t< expression<T> > >
-: std::true_type {};
-
-template<template<class> class expression, class T>
-using is_detected = detector<expression, T>;
-
-template<template<class> class expression, class T, class R, class = void>
-struct type_detector : std::false_type {};
+template<class T>
+using formatter_t = decltype(lib::formatter<T>{}(std::declval<T const&>()));
 
-template<template<class> class expression, class T, class R>
-struct type_detector< expression, T, R, std::void_t< expression<T> > >
-: std::is_same<expression<T>, R> {};
+template<class T>
+using formatter_append_t = decltype(lib::formatter<T>{}(std::declval<T const&>(),
+                                                        std::declval<std::string&>()));
 
-template<template<class> class expression, class T, class R>
-using is_detected_type = type_detector<expression, T, R>;
+// Write to the specified '[first, last)' the shortest representation of the
+// specified floating point 'obj' that round-trips, laid out as 'fmt' does by
+// default; return the end of the written characters. The behaviour is
+// undefined unless the range can hold the result.
+template<class T>
+char* to_chars_shortest(char* first, char* last, T obj)
+{
+  // Magnitudes in '[1e-4, 1e16)' have exponents in '[-4, 16)'. Below the first
+  // integer that is not exactly representable, the shortest fixed notation that
+  // round-trips has the same digits as the scientific one, and is faster to get.
+  constexpr auto exact = static_cast<double>(std::uint64_t{1} << std::numeric_limits<T>::digits);
+  auto const magnitude = static_cast<double>(obj < 0 ? -obj : obj);
+  if (1e-4 <= magnitude && magnitude < std::min(1e16, exact)) {
+    return std::to_chars(first, last, obj, std::chars_format::fixed).ptr;
+  }
 
-// Expressions for equality comparison
+  // Otherwise, start from the scientific notation, which yields digits and
+  // exponent.
+  auto const end = std::to_chars(first, last, obj, std::chars_format::scientific).ptr;
+  auto const e = static_cast<char*>(std::memchr(first, 'e', end - first));
+  if (e == nullptr) return end; // infinity or NaN
+  int exponent = 0;
+  std::from_chars(e + (e[1] == '+' ? 2 : 1), end, exponent);
+  if (exponent < -4 || 16 <= exponent) return end;
+
+  // Lay out the digits in fixed notation.
+  char digits[64];
+  int count = 0;
+  auto out = first + (*first == '-');
+  for (auto it = out; it != e; ++it) {
+    if (*it != '.') digits[count++] = *it;
+  }
+  if (exponent >= 0) {
+    for (int i = 0; i <= exponent; ++i) {
+      *out++ = i < count ? digits[i] : '0';
+    }
+    if (count > exponent + 1) {
+      *out++ = '.';
+      out = std::copy(digits + exponent + 1, digits + count, out);
+    }
+  }
+  else {
+    *out++ = '0';
+    *out++ = '.';
+    out = std::fill_n(out, -exponent - 1, '0');
+    out = std::copy(digits, digits + count, out);
+  }
+  return out;
+}
 
-template<class T>
-using equality_compare_t   = decltype(std::declval<T const&>() == std::declval<T const&>());
-template<class T>
-using inequality_compare_t = decltype(std::declval<T const&>() != std::declval<T const&>());
+} // namespace lib::detail
 
 template<class T>
-using lib_print_t = decltype(lib::print(std::declval<T const&>()));
+struct lib::is_formattable
+: ttl::detail::is_detected_type<lib::detail::formatter_t, T, std::string> {};
 
-} // unnamed namespace
+template<typename T>
+std::string lib::to_chars_formatter<T>::operator () (T const& obj)
+{
+  std::string result;
+  (*this)(obj, result);
+  return result;
+}
 
-template<class T>
-struct ttl::is_equality_comparable
-: std::conjunction < ::is_detected_type<equality_compare_t, T, bool>
-                   , ::is_detected_type<inequality_compare_t, T, bool> > {};
+template<typename T>
+void lib::to_chars_formatter<T>::operator () (T const& obj, std::string& buffer)
+{
+  char chars[64]; // large enough for any arithmetic type
+  char* end;
+  if constexpr (std::is_floating_point_v<T>) {
+    end = lib::detail::to_chars_shortest(chars, chars + sizeof(chars), obj);
+  }
+  else {
+    end = std::to_chars(chars, chars + sizeof(chars), obj).ptr;
+  }
+  buffer.append(chars, end);
+}
 
-template<class T>
-struct lib::is_printable
-: std::conjunction < ttl::is_semiregular<T>
-                   , ::is_detected_type<lib_print_t, T, void> > {};
+template<typename T>
+void lib::format_to(T const& obj, std::string& buffer)
+{
+  if constexpr (ttl::detail::is_detected<lib::detail::formatter_append_t, T>::value) {
+    lib::formatter<T>{}(obj, buffer);
+  }
+  else {
+    buffer += lib::formatter<T>{}(obj);
+  }
+}
 
 #endif // IS_PRINTABLE_FMT_HPP_INCLUDE_GUARD
@@ -6,11 +6,59 @@
 // to implement 'ttl::is_regular', such as 'ttl::is_copyable' and
 // 'ttl::is_equality_comparable'.
 // Note that this is a simplified implementation, not fully conformant.
+// When compiling with concepts, the traits forward to the concepts
+// 'ttl::movable', 'ttl::copyable', 'ttl::semiregular',
+// 'ttl::equality_comparable' and 'ttl::regular'.
 
 #include <type_traits>
 
+#include "detection.hpp"
+
 namespace ttl { // type traits library
 
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+// When concepts are available, the traits are implemented in terms of them:
+// checking a concept is cheaper to compile than instantiating the chains of
+// class templates below, and its result is cached by the compiler.
+
+// Movable
+template<class T>
+concept movable = std::is_object_v<T>
+               && std::is_move_constructible_v<T>
+               && std::is_assignable_v<T&, T>
+               && std::is_swappable_v<T>;
+// Copyable
+template<class T>
+concept copyable = ttl::movable<T>
+                && std::is_copy_constructible_v<T>
+                && std::is_assignable_v<T&, T const&>
+                && std::is_assignable_v<T&, T&>;
+// Semiregular
+template<class T>
+concept semiregular = ttl::copyable<T>
+                   && std::is_default_constructible_v<T>;
+// Equality Comparable
+template<class T>
+concept equality_comparable = requires(T const& a, T const& b) {
+  requires std::is_same_v<decltype(a == b), bool>;
+  requires std::is_same_v<decltype(a != b), bool>;
+};
+// Regular
+template<class T>
+concept regular = ttl::semiregular<T>
+               && ttl::equality_comparable<T>;
+
+// The traits remain class templates, as without concepts, so that they can be
+// specialized in the same way; as without concepts, 'ttl::is_regular' honors
+// the specializations of 'ttl::is_equality_comparable'.
+template<class T> struct is_movable             : std::bool_constant<ttl::movable<T>> {};
+template<class T> struct is_copyable            : std::bool_constant<ttl::copyable<T>> {};
+template<class T> struct is_semiregular         : std::bool_constant<ttl::semiregular<T>> {};
+template<class T> struct is_equality_comparable : std::bool_constant<ttl::equality_comparable<T>> {};
+template<class T> struct is_regular
+: std::bool_constant<ttl::semiregular<T> && ttl::is_equality_comparable<T>::value> {};
+
+#else
 // Movable
 template<class T>
 using is_movable = std::conjunction < std::is_object<T>
@@ -38,6 +86,8 @@ template<class T>
 using is_regular = std::conjunction < ttl::is_semiregular<T>
                                     , ttl::is_equality_comparable<T> >;
 
+#endif
+
 // Helper types and variables
 template<class T> using is_movable_t             = typename is_movable<T>::type;
 template<class T> using is_copyable_t            = typename is_copyable<T>::type;
@@ -45,38 +95,25 @@ template<class T> using is_semiregular_t         = typename is_semiregular<T>::t
 template<class T> using is_equality_comparable_t = typename is_equality_comparable<T>::type;
 template<class T> using is_regular_t             = typename is_regular<T>::type;
 
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+template<class T> constexpr bool is_movable_v             =  ttl::movable<T>;
+template<class T> constexpr bool is_copyable_v            =  ttl::copyable<T>;
+template<class T> constexpr bool is_semiregular_v         =  ttl::semiregular<T>;
+template<class T> constexpr bool is_equality_comparable_v =  is_equality_comparable<T>::value;
+template<class T> constexpr bool is_regular_v             =  is_regular<T>::value;
+#else
 template<class T> constexpr bool is_movable_v             =  is_movable<T>::value;
 template<class T> constexpr bool is_copyable_v            =  is_copyable<T>::value;
 template<class T> constexpr bool is_semiregular_v         =  is_semiregular<T>::value;
 template<class T> constexpr bool is_equality_comparable_v =  is_equality_comparable<T>::value;
 template<class T> constexpr bool is_regular_v             =  is_regular<T>::value;
+#endif
 
 } // namespace ttl
 
 // Implementation /////////////////////////////////////////////////////////////
 
-namespace {
-
-// Detection idiom
-template<template<class> class expression, class T, class = void>
-struct detector : std::false_type {};
-
-template<template<class> class expression, class T>
-struct detector< expression, T, std::void_t< expression<T> > >
-: std::true_type {};
-
-template<template<class> class expression, class T>
-using is_detected = detector<expression, T>;
-
-template<template<class> class expression, class T, class R, class = void>
-struct type_detector : std::false_type {};
-
-template<template<class> class expression, class T, class R>
-struct type_detector< expression, T, R, std::void_t< expression<T> > >
-: std::is_same<expression<T>, R> {};
-
-template<template<class> class expression, class T, class R>
-using is_detected_type = type_detector<expression, T, R>;
+namespace ttl::detail {
 
 // Expressions for equality comparison
 
@@ -85,11 +122,13 @@ using equality_compare_t   = decltype(std::declval<T const&>() == std::declval<T
 template<class T>
 using inequality_compare_t = decltype(std::declval<T const&>() != std::declval<T const&>());
 
-} // unnamed namespace
+} // namespace ttl::detail
 
+#if !defined(__cpp_concepts) || __cpp_concepts < 201907L
 template<class T>
 struct ttl::is_equality_comparable
-: std::conjunction < ::is_detected_type<equality_compare_t, T, bool>
-                   , ::is_detected_type<inequality_compare_t, T, bool> > {};
+: std::conjunction < ttl::detail::is_detected_type<ttl::detail::equality_compare_t, T, bool>
+                   , ttl::detail::is_detected_type<ttl::detail::inequality_compare_t, T, bool> > {};
+#endif
 
 #endif // IS_REGULAR_HPP_INCLUDE_GUARD
@@ -0,0 +1,49 @@
+#ifndef IS_TRIVIALLY_RELOCATABLE_HPP_INCLUDE_GUARD
+#define IS_TRIVIALLY_RELOCATABLE_HPP_INCLUDE_GUARD
+
+// This file defines a type trait, 'ttl::is_trivially_relocatable', modeled by
+// types whose objects can be moved to new storage by copying their bytes, the
+// original objects being then forgotten rather than destroyed. It additionally
+// provides 'ttl::is_bitwise_equality_comparable', modeled by types whose
+// objects compare equal if and only if their bytes do, so that they can be
+// compared with 'std::memcmp' and hashed through their bytes.
+// Unlike the traits of "is_regular.hpp", these properties cannot be detected:
+// both traits are customization points, which types opt in by specializing
+// them. Trivially copyable types are trivially relocatable by default.
+
+#include <memory> // unique_ptr
+#include <type_traits>
+
+namespace ttl { // type traits library
+
+// Trivially Relocatable
+// This class is a customization point, clients are free to specialize it as needed.
+template<class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// A 'std::unique_ptr' is trivially relocatable if its deleter and pointer are.
+template<class T, class D>
+struct is_trivially_relocatable< std::unique_ptr<T, D> >
+: std::conjunction < ttl::is_trivially_relocatable<D>
+                   , ttl::is_trivially_relocatable<typename std::unique_ptr<T, D>::pointer> > {};
+
+// Bitwise Equality Comparable
+// This class is a customization point, clients are free to specialize it as needed.
+// Unless specialized, only scalar types having unique object representations
+// (e.g. integers and pointers, but not floating point numbers) model it: the
+// equality of class types may ignore some of their members or padding.
+template<class T>
+struct is_bitwise_equality_comparable
+: std::conjunction < std::is_scalar<T>
+                   , std::has_unique_object_representations<T> > {};
+
+// Helper types and variables
+template<class T> using is_trivially_relocatable_t       = typename is_trivially_relocatable<T>::type;
+template<class T> using is_bitwise_equality_comparable_t = typename is_bitwise_equality_comparable<T>::type;
+
+template<class T> constexpr bool is_trivially_relocatable_v       =  is_trivially_relocatable<T>::value;
+template<class T> constexpr bool is_bitwise_equality_comparable_v =  is_bitwise_equality_comparable<T>::value;
+
+} // namespace ttl
+
+#endif // IS_TRIVIALLY_RELOCATABLE_HPP_INCLUDE_GUARD
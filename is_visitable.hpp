@@ -0,0 +1,229 @@
+#ifndef IS_VISITABLE_HPP_INCLUDE_GUARD
+#define IS_VISITABLE_HPP_INCLUDE_GUARD
+
+// This file defines a type trait, 'ttl::is_visitable', modeled by types whose
+// fields can be enumerated at compile time, together with the customization
+// point 'ttl::fields_tie' enumerating them and the functions 'ttl::tie_fields'
+// and 'ttl::visit_fields' built on it. Unless specialized, aggregates are
+// visitable: the number of their fields is found by checking how many
+// initializers they accept, and their fields are bound by structured bindings,
+// so that generic operations on them are fully inlined.
+// Note that aggregates having base classes, array members or bit-fields, or
+// more than 'ttl::max_visitable_fields' fields, are not supported.
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility> // declval, index_sequence
+
+#include "detection.hpp"
+
+namespace ttl { // type traits library
+
+// Maximum number of fields of the aggregates visitable by default.
+inline constexpr std::size_t max_visitable_fields = 16;
+
+// Number of fields of aggregates, or '0' for other types.
+template<class T>
+struct aggregate_field_count; // Implemented below
+
+template<class T>
+constexpr std::size_t aggregate_field_count_v = aggregate_field_count<T>::value;
+
+// Invokable class returning a 'std::tuple' of references to the fields of
+// objects of type 'T', in order.
+// This class is a customization point, clients are free to specialize it as needed.
+// The second parameter is reserved for the library.
+template<class T, class = void>
+struct fields_tie
+{
+  // Intentionally empty: 'T' is not visitable.
+};
+
+template<class T>
+struct fields_tie<T, std::enable_if_t< (ttl::aggregate_field_count_v<T> > 0) >>
+{
+  // Return a tuple of references to the fields of the specified 'obj'.
+  auto operator () (T& obj) const noexcept;
+  auto operator () (T const& obj) const noexcept;
+};
+
+// Visitable
+template<class T>
+struct is_visitable; // Implemented below
+
+// Helper types and variables
+template<class T> using is_visitable_t = typename is_visitable<T>::type;
+template<class T> constexpr bool is_visitable_v = is_visitable<T>::value;
+
+// Return a 'std::tuple' of references to the fields of the specified 'obj',
+// as if by calling 'ttl::fields_tie<T>{}(obj)', where 'T' is the type of
+// 'obj' without qualifiers.
+template<class T>
+auto tie_fields(T& obj) noexcept;
+
+// Call the specified 'f' on each field of the specified 'obj', in order.
+template<class T, class F>
+void visit_fields(T& obj, F&& f);
+
+} // namespace ttl
+
+// Implementation /////////////////////////////////////////////////////////////
+
+namespace ttl::detail {
+
+// Object convertible to any type, standing for the initializer of a field.
+struct any_field
+{
+  template<class U>
+  operator U () const; // Not defined: only used in unevaluated contexts.
+};
+
+template<class T, class Indices, class = void>
+struct is_initializable_by : std::false_type {};
+
+// Whether 'T' can be list-initialized from 'sizeof...(I)' objects.
+template<class T, std::size_t... I>
+struct is_initializable_by< T, std::index_sequence<I...>,
+                            std::void_t< decltype(T{ (void(I), any_field{})... }) > >
+: std::true_type {};
+
+// Return the number of fields of the aggregate 'T', that is the largest
+// number of initializers it accepts, looking for at most 'N'.
+template<class T, std::size_t N = ttl::max_visitable_fields>
+constexpr std::size_t count_fields()
+{
+  if constexpr (N == 0) {
+    return 0;
+  }
+  else if constexpr (is_initializable_by<T, std::make_index_sequence<N>>::value) {
+    return N;
+  }
+  else {
+    return count_fields<T, N - 1>();
+  }
+}
+
+// Return a tuple of references to the specified 'N' fields of 'obj'.
+template<std::size_t N, class T>
+auto tie_aggregate(T& obj) noexcept
+{
+  if constexpr (N == 1) {
+    auto& [f1] = obj;
+    return std::tie(f1);
+  }
+  else if constexpr (N == 2) {
+    auto& [f1, f2] = obj;
+    return std::tie(f1, f2);
+  }
+  else if constexpr (N == 3) {
+    auto& [f1, f2, f3] = obj;
+    return std::tie(f1, f2, f3);
+  }
+  else if constexpr (N == 4) {
+    auto& [f1, f2, f3, f4] = obj;
+    return std::tie(f1, f2, f3, f4);
+  }
+  else if constexpr (N == 5) {
+    auto& [f1, f2, f3, f4, f5] = obj;
+    return std::tie(f1, f2, f3, f4, f5);
+  }
+  else if constexpr (N == 6) {
+    auto& [f1, f2, f3, f4, f5, f6] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6);
+  }
+  else if constexpr (N == 7) {
+    auto& [f1, f2, f3, f4, f5, f6, f7] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7);
+  }
+  else if constexpr (N == 8) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8);
+  }
+  else if constexpr (N == 9) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9);
+  }
+  else if constexpr (N == 10) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+  }
+  else if constexpr (N == 11) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+  }
+  else if constexpr (N == 12) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+  }
+  else if constexpr (N == 13) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+  }
+  else if constexpr (N == 14) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+  }
+  else if constexpr (N == 15) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+  }
+  else if constexpr (N == 16) {
+    auto& [f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16] = obj;
+    return std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16);
+  }
+}
+
+// Return the number of fields of 'T' if it is an aggregate class, and '0'
+// otherwise.
+template<class T>
+constexpr std::size_t aggregate_field_count()
+{
+  if constexpr (std::is_class_v<T> && !std::is_union_v<T> && std::is_aggregate_v<T>) {
+    return count_fields<T>();
+  }
+  else {
+    return 0;
+  }
+}
+
+template<class T>
+using fields_tie_t = decltype(ttl::fields_tie<std::remove_cv_t<T>>{}(std::declval<T&>()));
+
+} // namespace ttl::detail
+
+template<class T>
+struct ttl::aggregate_field_count
+: std::integral_constant< std::size_t, ttl::detail::aggregate_field_count<T>() > {};
+
+template<class T>
+struct ttl::is_visitable
+: ttl::detail::is_detected<ttl::detail::fields_tie_t, T> {};
+
+template<class T>
+auto ttl::fields_tie<T, std::enable_if_t< (ttl::aggregate_field_count_v<T> > 0) >>::operator () (
+                                                          T& obj) const noexcept
+{
+  return ttl::detail::tie_aggregate<ttl::aggregate_field_count_v<T>>(obj);
+}
+
+template<class T>
+auto ttl::fields_tie<T, std::enable_if_t< (ttl::aggregate_field_count_v<T> > 0) >>::operator () (
+                                                    T const& obj) const noexcept
+{
+  return ttl::detail::tie_aggregate<ttl::aggregate_field_count_v<T>>(obj);
+}
+
+template<class T>
+auto ttl::tie_fields(T& obj) noexcept
+{
+  return ttl::fields_tie<std::remove_cv_t<T>>{}(obj);
+}
+
+template<class T, class F>
+void ttl::visit_fields(T& obj, F&& f)
+{
+  std::apply([&f](auto&... field) { (f(field), ...); }, ttl::tie_fields(obj));
+}
+
+#endif // IS_VISITABLE_HPP_INCLUDE_GUARD
@@ -0,0 +1,23 @@
+#ifndef MODULE_REQUIREMENTS_HPP_INCLUDE_GUARD
+#define MODULE_REQUIREMENTS_HPP_INCLUDE_GUARD
+
+// module_requirements.hpp
+// Included in the global module fragment of each module interface unit of this
+// directory, to reject compilers that cannot build them. The units export the
+// entities of the headers, included in their global module fragments, through
+// using-declarations, which requires a complete implementation of C++20
+// modules. GCC 12 builds 'ttl.traits', 'pdg.handle' and 'pdg.survival' with
+// '-fmodules-ts', but importers do not see their exported names, and it fails
+// on 'pdg.printable' with an internal error. The units have not been built with
+// a compiler supporting them yet: until they are, "pdg_pch.hpp" is the
+// supported way to avoid parsing the headers in every translation unit.
+// The units are built in the order of their imports:
+//   ttl.traits, pdg.handle, pdg.survival, pdg.printable
+
+#if !defined(__cpp_modules)
+#error "C++20 modules are not enabled: use modules/pdg_pch.hpp instead"
+#elif defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 14
+#error "GCC 14 or later is required to build the module units: use modules/pdg_pch.hpp instead"
+#endif
+
+#endif // MODULE_REQUIREMENTS_HPP_INCLUDE_GUARD
@@ -0,0 +1,21 @@
+// pdg.handle.cppm
+// Module interface unit of 'lib::Handle', in its latest version storing small
+// bodies in-place ("HandleImpl.v3.h"). The specialization of
+// 'ttl::is_trivially_relocatable' for 'lib::Handle' is reachable from
+// importers, together with the traits exported by 'ttl.traits'.
+
+module;
+
+#include "module_requirements.hpp"
+
+#include "../HandleImpl.v3.h"
+
+export module pdg.handle;
+
+export import ttl.traits;
+
+export namespace lib {
+
+using lib::Handle;
+
+} // namespace lib
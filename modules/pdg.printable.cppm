@@ -0,0 +1,84 @@
+// pdg.printable.cppm
+// Module interface unit of the printing facilities: the 'lib::printable'
+// concept and its customization points, the 'lib::PrintableValueProtocol'
+// protocol and its adapters, their binary and structured output formats, and
+// the output helpers built on 'lib::format'. 'fmt/core.h' is only parsed
+// when building this unit, instead of by every translation unit printing.
+
+module;
+
+#include "module_requirements.hpp"
+
+#include "../is_printable.hpp"
+#include "../is_printable_fmt.hpp"
+#include "../serializer.hpp"
+#include "../structured_output.hpp"
+#include "../PrintableValueProtocol.hpp"
+#include "../PrintableValueAdapter.hpp"
+#include "../MemoizingPrintableValueAdapter.hpp"
+#include "../PackedPrintableValues.hpp"
+#include "../parallel_print.hpp"
+#include "../buffered_print.hpp"
+#include "../MappedFileSink.hpp"
+#include "../aggregate.hpp"
+
+export module pdg.printable;
+
+export import ttl.traits;
+
+export namespace lib {
+
+// "is_printable.hpp"
+using lib::printer;
+using lib::print;
+using lib::is_printable;
+using lib::is_printable_t;
+using lib::is_printable_v;
+using lib::printable_ref;
+
+// "is_printable_fmt.hpp"
+using lib::formatter;
+using lib::to_chars_formatter;
+using lib::string_formatter;
+using lib::format;
+using lib::format_to;
+using lib::is_formattable;
+using lib::is_formattable_t;
+using lib::is_formattable_v;
+
+// "serializer.hpp"
+using lib::serialization_error;
+using lib::serializer;
+using lib::serialize;
+using lib::deserialize;
+using lib::is_serializable;
+using lib::is_serializable_t;
+using lib::is_serializable_v;
+
+// "structured_output.hpp"
+using lib::FieldEmitter;
+using lib::JsonEmitter;
+using lib::CsvEmitter;
+using lib::fields;
+using lib::emit;
+
+// "PrintableValueProtocol.hpp" and adapters
+using lib::PrintableValueProtocol;
+using lib::PrintableValueAdapter;
+using lib::MemoizingPrintableValueAdapter;
+using lib::PackedPrintableValues;
+
+// Output helpers
+using lib::parallel_print;
+using lib::buffered_print;
+using lib::flush_buffered_output;
+using lib::buffered_output_capacity;
+using lib::MappedFileSink;
+
+// "aggregate.hpp"
+using lib::aggregate_printer;
+using lib::aggregate_serializer;
+using lib::aggregate_equal;
+using lib::aggregate_hash;
+
+} // namespace lib
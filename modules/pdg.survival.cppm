@@ -0,0 +1,34 @@
+// pdg.survival.cppm
+// Module interface unit of the 'pdg::Survival' protocol, its implementations, and
+// the models built on it.
+
+module;
+
+#include "module_requirements.hpp"
+
+#include "../Survival.hpp"
+#include "../DayIndexedSurvival.hpp"
+#include "../PiecewiseHazardSurvival.hpp"
+#include "../CompositeSurvival.hpp"
+#include "../ProportionalHazards.hpp"
+#include "../WeibullSurvival.hpp"
+#include "../GompertzMakehamSurvival.hpp"
+#include "../LogLogisticSurvival.hpp"
+
+export module pdg.survival;
+
+export namespace pdg {
+
+using pdg::Probability;
+using pdg::Time;
+using pdg::computation_error;
+using pdg::Survival;
+using pdg::DayIndexedSurvival;
+using pdg::PiecewiseHazardSurvival;
+using pdg::CompositeSurvival;
+using pdg::ProportionalHazards;
+using pdg::WeibullSurvival;
+using pdg::GompertzMakehamSurvival;
+using pdg::LogLogisticSurvival;
+
+} // namespace pdg
@@ -0,0 +1,64 @@
+#ifndef PDG_PCH_HPP_INCLUDE_GUARD
+#define PDG_PCH_HPP_INCLUDE_GUARD
+
+// pdg_pch.hpp
+// Prefix header for builds using precompiled headers. It includes all the
+// headers of the library, together with the standard and 'fmt' headers they
+// depend on, so that they are parsed once per build:
+//   g++     -std=c++17 [flags] -x c++-header pdg_pch.hpp -o pdg_pch.hpp.gch
+//   clang++ -std=c++17 [flags] -x c++-header pdg_pch.hpp -o pdg_pch.hpp.pch
+// and each translation unit is then compiled with '-include pdg_pch.hpp'
+// (with Clang, '-include-pch pdg_pch.hpp.pch'), using the same flags.
+// 'lib::Handle' is provided in its latest version, "HandleImpl.v3.h".
+// This header is also the fallback for compilers that cannot build the module
+// interface units of this directory; see "module_requirements.hpp".
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Third party
+#include <fmt/core.h>
+
+// Type traits library
+#include "../detection.hpp"
+#include "../is_regular.hpp"
+#include "../is_trivially_relocatable.hpp"
+#include "../algorithms.hpp"
+#include "../is_visitable.hpp"
+#include "../smart_vector.hpp"
+
+// Handle
+#include "../HandleImpl.v3.h"
+
+// Printing
+#include "../is_printable.hpp"
+#include "../is_printable_fmt.hpp"
+#include "../serializer.hpp"
+#include "../structured_output.hpp"
+#include "../PrintableValueProtocol.hpp"
+#include "../PrintableValueAdapter.hpp"
+#include "../MemoizingPrintableValueAdapter.hpp"
+#include "../PackedPrintableValues.hpp"
+#include "../parallel_print.hpp"
+#include "../buffered_print.hpp"
+#include "../MappedFileSink.hpp"
+#include "../aggregate.hpp"
+
+// Survival
+#include "../Survival.hpp"
+#include "../DayIndexedSurvival.hpp"
+#include "../PiecewiseHazardSurvival.hpp"
+#include "../CompositeSurvival.hpp"
+#include "../ProportionalHazards.hpp"
+#include "../WeibullSurvival.hpp"
+#include "../GompertzMakehamSurvival.hpp"
+#include "../LogLogisticSurvival.hpp"
+
+#endif // PDG_PCH_HPP_INCLUDE_GUARD
@@ -0,0 +1,82 @@
+// ttl.traits.cppm
+// Module interface unit of the type traits library: 'ttl::is_regular' and
+// related traits, 'ttl::is_trivially_relocatable' and
+// 'ttl::is_bitwise_equality_comparable', the algorithms and the container
+// 'ttl::smart_vector' dispatching on them, and 'ttl::is_visitable'. The
+// headers are included in the global module fragment, so that importers share
+// the declarations of the translation units including them; class templates
+// exported as customization points can still be specialized.
+
+module;
+
+#include "module_requirements.hpp"
+
+#include "../is_regular.hpp"
+#include "../is_trivially_relocatable.hpp"
+#include "../algorithms.hpp"
+#include "../is_visitable.hpp"
+#include "../smart_vector.hpp"
+
+export module ttl.traits;
+
+export namespace ttl {
+
+// "is_regular.hpp"
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+using ttl::movable;
+using ttl::copyable;
+using ttl::semiregular;
+using ttl::equality_comparable;
+using ttl::regular;
+#endif
+
+using ttl::is_movable;
+using ttl::is_copyable;
+using ttl::is_semiregular;
+using ttl::is_equality_comparable;
+using ttl::is_regular;
+
+using ttl::is_movable_t;
+using ttl::is_copyable_t;
+using ttl::is_semiregular_t;
+using ttl::is_equality_comparable_t;
+using ttl::is_regular_t;
+
+using ttl::is_movable_v;
+using ttl::is_copyable_v;
+using ttl::is_semiregular_v;
+using ttl::is_equality_comparable_v;
+using ttl::is_regular_v;
+
+// "is_trivially_relocatable.hpp"
+using ttl::is_trivially_relocatable;
+using ttl::is_trivially_relocatable_t;
+using ttl::is_trivially_relocatable_v;
+using ttl::is_bitwise_equality_comparable;
+using ttl::is_bitwise_equality_comparable_t;
+using ttl::is_bitwise_equality_comparable_v;
+
+// "algorithms.hpp"
+using ttl::copy_n;
+using ttl::relocate_n;
+using ttl::fill_n;
+using ttl::equal;
+
+// "is_visitable.hpp"
+using ttl::max_visitable_fields;
+using ttl::aggregate_field_count;
+using ttl::aggregate_field_count_v;
+using ttl::fields_tie;
+using ttl::is_visitable;
+using ttl::is_visitable_t;
+using ttl::is_visitable_v;
+using ttl::tie_fields;
+using ttl::visit_fields;
+
+// "smart_vector.hpp"
+using ttl::vector_layout;
+using ttl::smart_vector;
+using ttl::operator ==;
+using ttl::operator !=;
+
+} // namespace ttl
@@ -0,0 +1,131 @@
+#ifndef PARALLEL_PRINT_HPP_INCLUDE_GUARD
+#define PARALLEL_PRINT_HPP_INCLUDE_GUARD
+
+// This file defines 'lib::parallel_print', printing a range of formattable
+// objects to 'stdout' with the same output as writing 'lib::format' of each
+// of them in order, but formatting them concurrently: the range is split into
+// chunks, each chunk is formatted into its own buffer by a pool of threads,
+// and the buffers are written to 'stdout' in their original order.
+
+#include <cstddef>
+#include <iterator>
+#include <thread>
+
+#include "is_printable_fmt.hpp"
+
+namespace lib {
+
+// Print the objects in the specified range '[first, last)' to 'stdout', in
+// order, formatting chunks of the specified 'chunk_size' objects concurrently
+// on the specified number of 'threads' (at least one is used). The output is
+// the same as writing 'lib::format' of each object. If formatting throws an
+// exception, the output is truncated at a chunk boundary not after the
+// failing chunk, and the exception is rethrown.
+// The behaviour is undefined unless '0 < chunk_size'.
+template<class RandomIt>
+void parallel_print(RandomIt first, RandomIt last,
+                    std::size_t chunk_size = 4096,
+                    unsigned threads = std::thread::hardware_concurrency());
+
+} // namespace lib
+
+// Implementation /////////////////////////////////////////////////////////////
+#include <algorithm> // max, min
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>    // fwrite
+#include <exception>
+#include <mutex>
+#include <string>
+#include <vector>
+
+template<class RandomIt>
+void lib::parallel_print(RandomIt first, RandomIt last,
+                         std::size_t chunk_size, unsigned threads)
+{
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert( lib::is_formattable_v<value_type>, "value_type must be formattable");
+  assert( 0 < chunk_size );
+  threads = std::max(threads, 1u);
+
+  auto const size   = static_cast<std::size_t>(std::distance(first, last));
+  auto const chunks = (size + chunk_size - 1) / chunk_size;
+  // Bound the number of formatted chunks waiting to be written, so that the
+  // memory used does not depend on the size of the range.
+  auto const window = 4 * std::size_t{threads};
+
+  std::mutex              mutex;
+  std::condition_variable changed;
+  std::vector<std::string> buffers(window);
+  std::vector<char>        ready(window, false);
+  std::size_t              next    = 0; // first chunk not yet claimed
+  std::size_t              written = 0; // first chunk not yet written
+  std::exception_ptr       error;
+
+  auto format_chunks = [&] {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      changed.wait(lock, [&] {
+        return error || next == chunks || next < written + window;
+      });
+      if (error || next == chunks) return;
+      auto const chunk = next++;
+      lock.unlock();
+
+      std::string buffer;
+      try {
+        auto it        = first + static_cast<std::ptrdiff_t>(chunk * chunk_size);
+        auto const end = first + static_cast<std::ptrdiff_t>(
+                                   std::min(size, (chunk + 1) * chunk_size));
+        for (; it != end; ++it) {
+          lib::format_to(*it, buffer);
+        }
+      }
+      catch (...) {
+        lock.lock();
+        if (!error) error = std::current_exception();
+        changed.notify_all();
+        return;
+      }
+
+      lock.lock();
+      buffers[chunk % window] = std::move(buffer);
+      ready[chunk % window] = true;
+      changed.notify_all();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  try {
+    pool.reserve(threads);
+    for (unsigned i = 0; i != threads; ++i) {
+      pool.emplace_back(format_chunks);
+    }
+  }
+  catch (...) { // stop the threads already started, and report the failure.
+    std::lock_guard<std::mutex> lock(mutex);
+    error = std::current_exception();
+    changed.notify_all();
+  }
+
+  for (std::size_t chunk = 0; chunk != chunks; ++chunk) {
+    std::string buffer;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] { return error || ready[chunk % window]; });
+      if (!ready[chunk % window]) break; // formatting failed
+      buffer.swap(buffers[chunk % window]);
+      ready[chunk % window] = false;
+      written = chunk + 1;
+    }
+    changed.notify_all();
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+  }
+
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+#endif // PARALLEL_PRINT_HPP_INCLUDE_GUARD
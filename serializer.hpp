@@ -0,0 +1,184 @@
+#ifndef SERIALIZER_HPP_INCLUDE_GUARD
+#define SERIALIZER_HPP_INCLUDE_GUARD
+
+// This file defines a customization point, 'lib::serializer', that encodes
+// objects to and decodes them from a compact binary representation, together
+// with the functions 'lib::serialize' and 'lib::deserialize' built on it.
+// Arithmetic types other than 'long double', and enumeration types, are encoded
+// little-endian using their own width, whereas 'std::string' is encoded as a
+// 32-bit length followed by its characters. The type trait
+// 'lib::is_serializable' detects types for which 'lib::serializer' is available.
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace lib {
+
+// Type of exception thrown.
+struct serialization_error {};
+
+namespace detail {
+
+// 'true' if objects of type 'T' are encoded as a little-endian word of their
+// own width by 'lib::serializer', and 'false' otherwise.
+template<typename T>
+constexpr bool is_word_serializable_v = ( std::is_arithmetic_v<T>
+                                       && !std::is_same_v<T, long double> )
+                                     || std::is_enum_v<T>;
+
+} // namespace detail
+
+// Invokable class that encodes objects of type 'T' to, and decodes them from,
+// a buffer of bytes. This class is a customization point, clients are free to
+// specialize it as needed; the second parameter is reserved for the library.
+// Unless specialized, only arithmetic and enumeration types are supported,
+// with the exception of 'long double', whose representation is not portable.
+template<typename T, typename = void>
+struct serializer
+{
+  // Intentionally empty: 'T' is not serializable.
+};
+
+template<typename T>
+struct serializer<T, std::enable_if_t< detail::is_word_serializable_v<T> >>
+{
+  // Append the little-endian encoding of the specified 'obj' to the
+  // specified 'buffer'.
+  void operator () (T const& obj, std::string& buffer);
+
+  // Decode an object from the front of the specified 'buffer', and remove the
+  // consumed bytes from it. A 'lib::serialization_error' is thrown if
+  // 'buffer' is too short.
+  T operator () (std::string_view& buffer);
+};
+
+template<>
+struct serializer<std::string>
+{
+  // Append the length of the specified 'obj', as a 32-bit integer, followed
+  // by its characters to the specified 'buffer'. A 'lib::serialization_error'
+  // is thrown if 'obj' is too long to be encoded.
+  void operator () (std::string const& obj, std::string& buffer);
+
+  // Decode a string from the front of the specified 'buffer', and remove the
+  // consumed bytes from it. A 'lib::serialization_error' is thrown if
+  // 'buffer' is too short.
+  std::string operator () (std::string_view& buffer);
+};
+
+// Append the binary encoding of the specified 'obj' to the specified 'buffer',
+// as if by calling 'lib::serializer<T>{}(obj, buffer)'.
+template<typename T>
+void serialize(T const& obj, std::string& buffer) {
+  lib::serializer<T>{}(obj, buffer);
+}
+
+// Decode an object of type 'T' from the front of the specified 'buffer',
+// removing the consumed bytes, as if by calling 'lib::serializer<T>{}(buffer)'.
+template<typename T>
+T deserialize(std::string_view& buffer) {
+  return lib::serializer<T>{}(buffer);
+}
+
+// 'lib::serializable' concept
+template<class T, class = void>
+struct is_serializable; // Implemented below
+
+template<class T> using is_serializable_t = typename is_serializable<T>::type;
+template<class T> constexpr bool is_serializable_v =  is_serializable<T>::value;
+
+} // namespace lib
+
+// Implementation /////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <cstring> // memcpy
+#include <limits>
+#include <utility> // declval
+
+template<class T, class>
+struct lib::is_serializable : std::false_type {};
+
+template<class T>
+struct lib::is_serializable< T, std::void_t<
+  decltype(lib::serializer<T>{}(std::declval<T const&>(), std::declval<std::string&>())),
+  decltype(lib::serializer<T>{}(std::declval<std::string_view&>())) > >
+: std::is_same< decltype(lib::serializer<T>{}(std::declval<std::string_view&>())), T > {};
+
+namespace lib::detail {
+
+// Return the unsigned integer type having the same size as 'T'.
+template<class T>
+auto serializer_word() {
+  if constexpr      (sizeof(T) == 1) return std::uint8_t{};
+  else if constexpr (sizeof(T) == 2) return std::uint16_t{};
+  else if constexpr (sizeof(T) == 4) return std::uint32_t{};
+  else if constexpr (sizeof(T) == 8) return std::uint64_t{};
+}
+
+template<class T>
+using serializer_word_t = decltype(lib::detail::serializer_word<T>());
+
+} // namespace lib::detail
+
+template<typename T>
+void lib::serializer<T, std::enable_if_t<
+                         lib::detail::is_word_serializable_v<T> >>::operator () (
+                                             T const& obj, std::string& buffer)
+{
+  using Word = lib::detail::serializer_word_t<T>;
+  static_assert( sizeof(Word) == sizeof(T), "unsupported arithmetic type" );
+  Word word;
+  std::memcpy(&word, &obj, sizeof(T));
+  // Shifting makes the encoding independent of the host byte order.
+  char bytes[sizeof(T)];
+  for (std::size_t i = 0; i != sizeof(T); ++i) {
+    bytes[i] = static_cast<char>(static_cast<unsigned char>(word >> (8 * i)));
+  }
+  buffer.append(bytes, sizeof(T));
+}
+
+template<typename T>
+auto lib::serializer<T, std::enable_if_t<
+                         lib::detail::is_word_serializable_v<T> >>::operator () (
+                                                      std::string_view& buffer)
+-> T
+{
+  using Word = lib::detail::serializer_word_t<T>;
+  if (buffer.size() < sizeof(T)) throw lib::serialization_error{};
+  Word word = 0;
+  for (std::size_t i = 0; i != sizeof(T); ++i) {
+    word |= static_cast<Word>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+  }
+  buffer.remove_prefix(sizeof(T));
+  if constexpr (std::is_same_v<T, bool>) { // not every byte is a valid 'bool'
+    return word != 0;
+  }
+  else {
+    T result;
+    std::memcpy(&result, &word, sizeof(T));
+    return result;
+  }
+}
+
+inline void lib::serializer<std::string>::operator () (std::string const& obj,
+                                                       std::string& buffer)
+{
+  if (obj.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw lib::serialization_error{};
+  }
+  lib::serialize(static_cast<std::uint32_t>(obj.size()), buffer);
+  buffer.append(obj);
+}
+
+inline auto lib::serializer<std::string>::operator () (std::string_view& buffer)
+-> std::string
+{
+  auto const size = lib::deserialize<std::uint32_t>(buffer);
+  if (buffer.size() < size) throw lib::serialization_error{};
+  std::string result(buffer.substr(0, size));
+  buffer.remove_prefix(size);
+  return result;
+}
+
+#endif // SERIALIZER_HPP_INCLUDE_GUARD
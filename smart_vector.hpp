@@ -0,0 +1,599 @@
+#ifndef SMART_VECTOR_HPP_INCLUDE_GUARD
+#define SMART_VECTOR_HPP_INCLUDE_GUARD
+
+// This file defines 'ttl::smart_vector', a sequence container similar to
+// 'std::vector' whose storage strategy is selected at compile time from the
+// properties of its elements:
+//: o 'small_buffer': tiny trivially copyable elements are stored in a buffer
+//:   inside the object until it is full, then on the heap, grown by 'realloc'.
+//: o 'reallocating': trivially relocatable elements are stored on the heap,
+//:   grown by 'realloc', which may extend the storage in place and otherwise
+//:   copies the bytes of the elements.
+//: o 'moving': other elements are stored on the heap, and moved one by one
+//:   to a new storage when it grows, as 'std::vector' does.
+// The container is as regular as its elements allow: it is copyable only if
+// they are copy constructible, and equality comparable only if they are, so
+// that 'ttl::is_regular' and 'ttl::is_semiregular' report it accurately.
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "algorithms.hpp"
+#include "is_regular.hpp"
+#include "is_trivially_relocatable.hpp"
+
+namespace ttl { // type traits library
+
+// Storage strategies of 'ttl::smart_vector'; see the file description.
+enum class vector_layout { small_buffer, reallocating, moving };
+
+namespace detail {
+
+// Return the number of elements of type 'T' stored inside a
+// 'ttl::smart_vector', '0' if they are not tiny and trivially copyable.
+template<class T>
+constexpr std::size_t smart_vector_inline_capacity()
+{
+  if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= 16
+                && alignof(T) <= alignof(std::max_align_t)) {
+    return 64 / sizeof(T);
+  }
+  else {
+    return 0;
+  }
+}
+
+// Buffer holding up to 'N' objects of type 'T', empty if 'N' is '0'.
+template<class T, std::size_t N>
+struct small_buffer
+{
+  alignas(T) unsigned char bytes_[N * sizeof(T)];
+  T* small_data() noexcept { return reinterpret_cast<T*>(bytes_); }
+};
+
+template<class T>
+struct small_buffer<T, 0>
+{
+  T* small_data() noexcept { return nullptr; }
+};
+
+// Type of the source of the copy operations of 'ttl::smart_vector<T>': the
+// specified 'V' if 'T' is copy constructible, and otherwise an unrelated type,
+// so that the copy operations of 'V' are implicitly deleted.
+struct not_copy_source {};
+
+template<class V, class T>
+using copy_source_t = std::conditional_t< std::is_copy_constructible_v<T>
+                                        , V, not_copy_source >;
+
+} // namespace detail
+
+/******************************************************************************
+* class ttl::smart_vector
+******************************************************************************/
+// This class provides a sequence of objects of type 'T', stored contiguously,
+// whose layout is selected at compile time; see the file description.
+// References to the elements are invalidated when the storage grows.
+// 'T' must be nothrow move constructible, unless it is copy constructible.
+template<class T>
+class smart_vector
+: private ttl::detail::small_buffer<T, ttl::detail::smart_vector_inline_capacity<T>()>
+{
+public:
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = T&;
+  using const_reference = T const&;
+  using pointer         = T*;
+  using const_pointer   = T const*;
+  using iterator        = T*;
+  using const_iterator  = T const*;
+
+  // Number of elements stored inside the object, before allocating.
+  static constexpr size_type inline_capacity =
+                                ttl::detail::smart_vector_inline_capacity<T>();
+
+  // Storage strategy used for 'T'.
+  static constexpr ttl::vector_layout layout =
+      inline_capacity != 0 ? ttl::vector_layout::small_buffer
+    : (ttl::is_trivially_relocatable_v<T>
+        && alignof(T) <= alignof(std::max_align_t)) ? ttl::vector_layout::reallocating
+    : ttl::vector_layout::moving;
+
+private:
+  using copy_source = ttl::detail::copy_source_t<smart_vector, T>;
+
+  T*        data_;
+  size_type size_;
+  size_type capacity_;
+
+public:
+  // Create an empty sequence. No memory is allocated.
+  smart_vector() noexcept;
+  // Create a sequence of the specified 'count' value-initialized objects.
+  explicit smart_vector(size_type count);
+  // Create a sequence of the specified 'count' copies of the specified 'value'.
+  smart_vector(size_type count, T const& value);
+  // Create a sequence of copies of the objects in the specified 'init'.
+  smart_vector(std::initializer_list<T> init);
+
+  /* Rule of 5 */
+  // The copy operations are deleted unless 'T' is copy constructible.
+  smart_vector(copy_source const& other);
+  smart_vector(smart_vector && other) noexcept;
+
+  ~smart_vector() noexcept;
+
+  smart_vector& operator = (copy_source const& other);
+  smart_vector& operator = (smart_vector && other) noexcept;
+
+  // Return the number of elements.
+  size_type size() const noexcept;
+  // Return the number of elements that can be held without allocating.
+  size_type capacity() const noexcept;
+  // Return the maximum number of elements that can be held.
+  size_type max_size() const noexcept;
+  // Return 'true' if there are no elements, and 'false' otherwise.
+  bool empty() const noexcept;
+
+  // Return a pointer to the first element.
+  T*       data()       noexcept;
+  T const* data() const noexcept;
+
+  iterator       begin()       noexcept;
+  const_iterator begin() const noexcept;
+  iterator       end()         noexcept;
+  const_iterator end()   const noexcept;
+
+  // Return a reference to the element at the specified 'index'.
+  // The behaviour is undefined unless 'index < size()'.
+  T&       operator [] (size_type index)       noexcept;
+  T const& operator [] (size_type index) const noexcept;
+
+  // Return a reference to the first, or last, element.
+  // The behaviour is undefined if this sequence is empty.
+  T&       front()       noexcept;
+  T const& front() const noexcept;
+  T&       back()        noexcept;
+  T const& back()  const noexcept;
+
+  // Append a copy of the specified 'value'.
+  void push_back(T const& value);
+  // Append the specified 'value', moved.
+  void push_back(T && value);
+  // Append an object constructed from the specified 'args', and return a
+  // reference to it.
+  template<class... Args>
+  T& emplace_back(Args&&... args);
+
+  // Destroy the last element.
+  // The behaviour is undefined if this sequence is empty.
+  void pop_back() noexcept;
+
+  // Destroy all the elements, keeping the storage for reuse.
+  void clear() noexcept;
+
+  // Ensure that the specified 'count' elements can be held without allocating.
+  void reserve(size_type count);
+
+  // Make the size of this sequence the specified 'count', destroying the last
+  // elements or appending value-initialized ones, or copies of the specified
+  // 'value', as needed.
+  void resize(size_type count);
+  void resize(size_type count, T const& value);
+
+private:
+  // Return 'true' if the elements are stored inside this object.
+  bool is_small() const noexcept;
+
+  // Grow the storage to hold at least the specified 'count' elements,
+  // relocating the elements. A 'std::length_error' is thrown if 'count' is
+  // greater than 'max_size()'.
+  void grow(size_type count);
+
+  // Return the capacity to grow to, so as to hold the specified 'count'
+  // elements with amortized constant time insertions.
+  size_type next_capacity(size_type count) const noexcept;
+
+  // Release the storage, if allocated. The behaviour is undefined unless the
+  // elements have been destroyed, or relocated.
+  void deallocate() noexcept;
+
+  // Move the elements of the specified 'other' to this object, leaving 'other'
+  // empty. The behaviour is undefined unless this object is empty and has no
+  // allocated storage.
+  void steal(smart_vector& other) noexcept;
+};
+
+// Return 'true' if the specified 'lhs' and 'rhs' have the same size, and their
+// elements compare equal, and 'false' otherwise. This function only takes
+// part in overload resolution if 'T' is equality comparable.
+template<class T, class = std::enable_if_t< ttl::is_equality_comparable_v<T> >>
+bool operator == (smart_vector<T> const& lhs, smart_vector<T> const& rhs);
+
+// Return 'true' if the specified 'lhs' and 'rhs' do not have the same value,
+// and 'false' otherwise. This function only takes part in overload resolution
+// if 'T' is equality comparable.
+template<class T, class = std::enable_if_t< ttl::is_equality_comparable_v<T> >>
+bool operator != (smart_vector<T> const& lhs, smart_vector<T> const& rhs);
+
+} // namespace ttl
+
+// Implementation /////////////////////////////////////////////////////////////
+#include <algorithm> // max, min
+#include <cassert>
+#include <cstdlib>   // malloc, realloc, free
+#include <cstring>   // memcpy
+#include <limits>
+#include <memory>    // uninitialized_*, destroy
+#include <new>       // bad_alloc, align_val_t
+#include <stdexcept> // length_error
+#include <utility>   // move, forward
+
+template<class T>
+ttl::smart_vector<T>::smart_vector() noexcept
+: data_(this->small_data())
+, size_(0)
+, capacity_(inline_capacity)
+{ }
+
+template<class T>
+ttl::smart_vector<T>::smart_vector(size_type count)
+: smart_vector()
+{
+  resize(count);
+}
+
+template<class T>
+ttl::smart_vector<T>::smart_vector(size_type count, T const& value)
+: smart_vector()
+{
+  resize(count, value);
+}
+
+template<class T>
+ttl::smart_vector<T>::smart_vector(std::initializer_list<T> init)
+: smart_vector()
+{
+  reserve(init.size());
+  std::uninitialized_copy(init.begin(), init.end(), data_);
+  size_ = init.size();
+}
+
+template<class T>
+ttl::smart_vector<T>::smart_vector(copy_source const& other)
+: smart_vector()
+{
+  reserve(other.size_);
+  std::uninitialized_copy_n(other.data_, other.size_, data_);
+  size_ = other.size_;
+}
+
+template<class T>
+ttl::smart_vector<T>::smart_vector(smart_vector && other) noexcept
+: smart_vector()
+{
+  steal(other);
+}
+
+template<class T>
+ttl::smart_vector<T>::~smart_vector() noexcept
+{
+  clear();
+  deallocate();
+}
+
+template<class T>
+auto ttl::smart_vector<T>::operator = (copy_source const& other)
+-> smart_vector&
+{
+  // A variation of the copy-and-swap idiom.
+  auto tmp = other;
+  *this = std::move(tmp);
+  return *this;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::operator = (smart_vector && other) noexcept
+-> smart_vector&
+{
+  if (this != &other) {
+    clear();
+    deallocate();
+    steal(other);
+  }
+  return *this;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::size() const noexcept -> size_type
+{
+  return size_;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::capacity() const noexcept -> size_type
+{
+  return capacity_;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::max_size() const noexcept -> size_type
+{
+  // Differences of pointers to elements must be representable.
+  return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+}
+
+template<class T>
+bool ttl::smart_vector<T>::empty() const noexcept
+{
+  return size_ == 0;
+}
+
+template<class T>
+T* ttl::smart_vector<T>::data() noexcept
+{
+  return data_;
+}
+
+template<class T>
+T const* ttl::smart_vector<T>::data() const noexcept
+{
+  return data_;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::begin() noexcept -> iterator
+{
+  return data_;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::begin() const noexcept -> const_iterator
+{
+  return data_;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::end() noexcept -> iterator
+{
+  return data_ + size_;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::end() const noexcept -> const_iterator
+{
+  return data_ + size_;
+}
+
+template<class T>
+T& ttl::smart_vector<T>::operator [] (size_type index) noexcept
+{
+  assert( index < size_ );
+  return data_[index];
+}
+
+template<class T>
+T const& ttl::smart_vector<T>::operator [] (size_type index) const noexcept
+{
+  assert( index < size_ );
+  return data_[index];
+}
+
+template<class T>
+T& ttl::smart_vector<T>::front() noexcept
+{
+  assert( size_ != 0 );
+  return data_[0];
+}
+
+template<class T>
+T const& ttl::smart_vector<T>::front() const noexcept
+{
+  assert( size_ != 0 );
+  return data_[0];
+}
+
+template<class T>
+T& ttl::smart_vector<T>::back() noexcept
+{
+  assert( size_ != 0 );
+  return data_[size_ - 1];
+}
+
+template<class T>
+T const& ttl::smart_vector<T>::back() const noexcept
+{
+  assert( size_ != 0 );
+  return data_[size_ - 1];
+}
+
+template<class T>
+void ttl::smart_vector<T>::push_back(T const& value)
+{
+  emplace_back(value);
+}
+
+template<class T>
+void ttl::smart_vector<T>::push_back(T && value)
+{
+  emplace_back(std::move(value));
+}
+
+template<class T>
+template<class... Args>
+T& ttl::smart_vector<T>::emplace_back(Args&&... args)
+{
+  if (size_ == capacity_) {
+    // The arguments may refer to elements, invalidated by growing: the new
+    // element is constructed first.
+    T value(std::forward<Args>(args)...);
+    grow(next_capacity(size_ + 1));
+    ::new (static_cast<void*>(data_ + size_)) T(std::move(value));
+  }
+  else {
+    ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+  }
+  return data_[size_++];
+}
+
+template<class T>
+void ttl::smart_vector<T>::pop_back() noexcept
+{
+  assert( size_ != 0 );
+  data_[--size_].~T();
+}
+
+template<class T>
+void ttl::smart_vector<T>::clear() noexcept
+{
+  std::destroy_n(data_, size_);
+  size_ = 0;
+}
+
+template<class T>
+void ttl::smart_vector<T>::reserve(size_type count)
+{
+  if (count > capacity_) grow(count);
+}
+
+template<class T>
+void ttl::smart_vector<T>::resize(size_type count)
+{
+  if (count < size_) {
+    std::destroy(data_ + count, data_ + size_);
+  }
+  else {
+    if (count > capacity_) grow(std::max(count, next_capacity(size_ + 1)));
+    std::uninitialized_value_construct(data_ + size_, data_ + count);
+  }
+  size_ = count;
+}
+
+template<class T>
+void ttl::smart_vector<T>::resize(size_type count, T const& value)
+{
+  if (count < size_) {
+    std::destroy(data_ + count, data_ + size_);
+  }
+  else if (count > size_) {
+    if (count > capacity_) {
+      // 'value' may refer to an element, invalidated by growing.
+      T copy(value);
+      grow(std::max(count, next_capacity(size_ + 1)));
+      std::uninitialized_fill(data_ + size_, data_ + count, copy);
+    }
+    else {
+      std::uninitialized_fill(data_ + size_, data_ + count, value);
+    }
+  }
+  size_ = count;
+}
+
+template<class T>
+bool ttl::smart_vector<T>::is_small() const noexcept
+{
+  if constexpr (inline_capacity != 0) {
+    return data_ == const_cast<smart_vector*>(this)->small_data();
+  }
+  else {
+    return false;
+  }
+}
+
+template<class T>
+void ttl::smart_vector<T>::grow(size_type count)
+{
+  // Guard the computation of the size of the storage from overflowing.
+  if (count > max_size()) throw std::length_error("ttl::smart_vector");
+  if constexpr (layout == ttl::vector_layout::moving) {
+    auto const storage = static_cast<T*>(
+                 ::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+    if constexpr (std::is_nothrow_move_constructible_v<T>) {
+      ttl::relocate_n(data_, size_, storage);
+    }
+    else { // copy, so that the elements are left untouched if it throws.
+      try {
+        std::uninitialized_copy_n(data_, size_, storage);
+      }
+      catch (...) {
+        ::operator delete(storage, std::align_val_t{alignof(T)});
+        throw;
+      }
+      std::destroy_n(data_, size_);
+    }
+    deallocate();
+    data_ = storage;
+  }
+  else { // the elements are trivially relocatable
+    if (is_small()) {
+      auto const storage = static_cast<T*>(std::malloc(count * sizeof(T)));
+      if (storage == nullptr) throw std::bad_alloc{};
+      ttl::relocate_n(data_, size_, storage);
+      data_ = storage;
+    }
+    else { // also allocates if 'data_' is null
+      auto const storage = static_cast<T*>(
+                    std::realloc(static_cast<void*>(data_), count * sizeof(T)));
+      if (storage == nullptr) throw std::bad_alloc{};
+      data_ = storage;
+    }
+  }
+  capacity_ = count;
+}
+
+template<class T>
+auto ttl::smart_vector<T>::next_capacity(size_type count) const noexcept
+-> size_type
+{
+  return std::max(count, std::min(2 * capacity_, max_size()));
+}
+
+template<class T>
+void ttl::smart_vector<T>::deallocate() noexcept
+{
+  if (is_small() || data_ == nullptr) return;
+  if constexpr (layout == ttl::vector_layout::moving) {
+    ::operator delete(data_, std::align_val_t{alignof(T)});
+  }
+  else {
+    std::free(data_);
+  }
+  data_ = this->small_data();
+  capacity_ = inline_capacity;
+}
+
+template<class T>
+void ttl::smart_vector<T>::steal(smart_vector& other) noexcept
+{
+  if constexpr (inline_capacity != 0) {
+    if (other.is_small()) {
+      ttl::relocate_n(other.data_, other.size_, data_);
+      size_ = other.size_;
+      other.size_ = 0;
+      return;
+    }
+  }
+  data_     = other.data_;
+  size_     = other.size_;
+  capacity_ = other.capacity_;
+  other.data_     = other.small_data();
+  other.size_     = 0;
+  other.capacity_ = inline_capacity;
+}
+
+template<class T, class>
+bool ttl::operator == (smart_vector<T> const& lhs, smart_vector<T> const& rhs)
+{
+  return lhs.size() == rhs.size() && ttl::equal(lhs.data(), lhs.size(), rhs.data());
+}
+
+template<class T, class>
+bool ttl::operator != (smart_vector<T> const& lhs, smart_vector<T> const& rhs)
+{
+  return !(lhs == rhs);
+}
+
+#endif // SMART_VECTOR_HPP_INCLUDE_GUARD
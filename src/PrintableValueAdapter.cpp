@@ -0,0 +1,15 @@
+// PrintableValueAdapter.cpp
+// Explicit instantiations of 'lib::PrintableValueAdapter' for the most common
+// types, compiled once in the compiled-library mode; see "config.hpp".
+// The non-template functions are defined by "PrintableValueProtocol.cpp".
+
+#ifndef PDG_COMPILED_LIBRARY
+#define PDG_COMPILED_LIBRARY
+#endif
+#include "../PrintableValueAdapter.hpp"
+
+#include <string>
+
+PDG_INSTANTIATE_PRINTABLE_VALUE_ADAPTER(int);
+PDG_INSTANTIATE_PRINTABLE_VALUE_ADAPTER(double);
+PDG_INSTANTIATE_PRINTABLE_VALUE_ADAPTER(std::string);
@@ -0,0 +1,7 @@
+// PrintableValueProtocol.cpp
+// Definitions of the non-template functions of "PrintableValueProtocol.hpp",
+// including 'lib::PrintableValueProtocol::Default', compiled once in the
+// compiled-library mode; see "config.hpp".
+
+#define PDG_LIBRARY_SOURCE
+#include "../PrintableValueProtocol.hpp"
@@ -0,0 +1,15 @@
+// Survival.cpp
+// Definitions of the non-template functions of "Survival.hpp" and of the headers
+// of its implementations, compiled once in the compiled-library mode; see
+// "config.hpp". A library source defines those of all the headers it includes,
+// so that each header is included by exactly one of them.
+
+#define PDG_LIBRARY_SOURCE
+#include "../Survival.hpp"
+#include "../DayIndexedSurvival.hpp"
+#include "../PiecewiseHazardSurvival.hpp"
+#include "../CompositeSurvival.hpp"
+#include "../ProportionalHazards.hpp"
+#include "../WeibullSurvival.hpp"
+#include "../GompertzMakehamSurvival.hpp"
+#include "../LogLogisticSurvival.hpp"
@@ -0,0 +1,395 @@
+#ifndef STRUCTURED_OUTPUT_HPP_INCLUDE_GUARD
+#define STRUCTURED_OUTPUT_HPP_INCLUDE_GUARD
+
+// This file defines a structured rendering mode for printable objects, meant
+// to be ingested by machines rather than read by humans. Objects are rendered
+// as records made of named fields: the customization point 'lib::fields'
+// enumerates the fields of an object, and an emitter implementing the
+// 'lib::FieldEmitter' protocol writes them in a given format. Two streaming
+// emitters are provided, 'lib::JsonEmitter' (JSON Lines) and 'lib::CsvEmitter',
+// both writing directly into a caller-supplied buffer without building any
+// intermediate representation of the records.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <fmt/core.h>
+
+#include "serializer.hpp" // serialization_error
+
+namespace lib {
+
+/******************************************************************************
+* class lib::FieldEmitter
+******************************************************************************/
+// This protocol class provides a pure abstract interface and contract which
+// models the writing of records made of named fields in a structured format.
+// A record is written by calling 'begin_record', then 'field' for each field
+// and finally 'end_record'.
+class FieldEmitter
+{
+public:
+  // Destroy this object.
+  virtual ~FieldEmitter() noexcept = 0;
+  // Suppress assignment through abstract protocol.
+  FieldEmitter& operator = (FieldEmitter const&) = delete;
+
+  // Start a new record.
+  void begin_record();
+
+  // Write a field of the current record having the specified 'name' and
+  // 'value'. Booleans, integers and floating point numbers are written as
+  // such, characters as one-character strings, objects convertible to
+  // 'std::string_view' as strings, and any other object as the string
+  // 'fmt::format("{}", value)'. A 'lib::serialization_error' is thrown if
+  // 'fmt' cannot format 'value', so that 'lib::fields<T>' can be instantiated
+  // for any 'T', e.g. by adapters whose 'T' is only printed through a
+  // specialized customization point.
+  template<class V>
+  void field(std::string_view name, V const& value);
+
+  // End the current record.
+  void end_record();
+
+private: /* virtual implementation */
+  // Implement the 'begin_record' contract.
+  virtual void begin_record_impl() = 0;
+  // Implement the 'field' contract, for each kind of value.
+  virtual void field_impl(std::string_view name, bool value) = 0;
+  virtual void field_impl(std::string_view name, std::int64_t value) = 0;
+  virtual void field_impl(std::string_view name, std::uint64_t value) = 0;
+  virtual void field_impl(std::string_view name, double value) = 0;
+  virtual void field_impl(std::string_view name, std::string_view value) = 0;
+  // Implement the 'end_record' contract.
+  virtual void end_record_impl() = 0;
+
+  // Write a field having the specified 'name' and, as its value, the string
+  // formatted by 'fmt' from the specified 'args'. This function is not a
+  // template, so that formatting is not compiled once per type of value.
+  void formatted_field(std::string_view name, fmt::format_args args);
+};
+
+/******************************************************************************
+* class lib::JsonEmitter
+******************************************************************************/
+// This class implements the 'lib::FieldEmitter' protocol, appending each record
+// to a buffer as a JSON object followed by a newline (JSON Lines). Non-finite
+// floating point numbers are written as 'null'.
+class JsonEmitter final : public lib::FieldEmitter
+{
+  std::string& buffer_;
+  bool         first_field_ = true;
+public:
+  // Create an emitter appending records to the specified 'buffer'.
+  explicit JsonEmitter(std::string& buffer) noexcept;
+
+private:
+  void begin_record_impl() override;
+  void field_impl(std::string_view name, bool value) override;
+  void field_impl(std::string_view name, std::int64_t value) override;
+  void field_impl(std::string_view name, std::uint64_t value) override;
+  void field_impl(std::string_view name, double value) override;
+  void field_impl(std::string_view name, std::string_view value) override;
+  void end_record_impl() override;
+
+  // Append the separator and the quoted specified 'name' of a field.
+  void key(std::string_view name);
+};
+
+/******************************************************************************
+* class lib::CsvEmitter
+******************************************************************************/
+// This class implements the 'lib::FieldEmitter' protocol, appending each record
+// to a buffer as a line of comma-separated values, quoted as per RFC 4180 when
+// needed. Optionally, a header line made of the field names of the first
+// record is written before it. All records are expected to have the same fields;
+// records having no fields, such as those of "null" values, are not written.
+class CsvEmitter final : public lib::FieldEmitter
+{
+  std::string& buffer_;
+  std::string  header_;       // field names of the first record.
+  bool         write_header_; // whether the header is still to be written.
+  std::size_t  record_begin_ = 0;
+  bool         first_field_  = true;
+public:
+  // Create an emitter appending records to the specified 'buffer', preceded
+  // by a header line if the specified 'header' is 'true'.
+  explicit CsvEmitter(std::string& buffer, bool header = true);
+
+private:
+  void begin_record_impl() override;
+  void field_impl(std::string_view name, bool value) override;
+  void field_impl(std::string_view name, std::int64_t value) override;
+  void field_impl(std::string_view name, std::uint64_t value) override;
+  void field_impl(std::string_view name, double value) override;
+  void field_impl(std::string_view name, std::string_view value) override;
+  void end_record_impl() override;
+
+  // Append the separator of a field having the specified 'name'.
+  void separator(std::string_view name);
+};
+
+// Invokable class that enumerates the fields of objects of type 'T'.
+// This class is a customization point, clients are free to specialize it as needed.
+template<typename T>
+struct fields // class template to support partial specialization
+{
+  // Write the fields of the specified 'obj' to the specified 'emitter'.
+  // Unless specialized, call 'emitter.field("value", obj)'.
+  template<class Emitter>
+  void operator () (T const& obj, Emitter& emitter) {
+    emitter.field("value", obj);
+  }
+};
+
+// Write the specified 'obj' as a record to the specified 'emitter', whose
+// fields are enumerated as if by calling 'lib::fields<T>{}(obj, emitter)'.
+template<typename T, class Emitter>
+void emit(T const& obj, Emitter& emitter) {
+  emitter.begin_record();
+  lib::fields<T>{}(obj, emitter);
+  emitter.end_record();
+}
+
+} // namespace lib
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////
+#include <charconv> // to_chars
+#include <cmath>    // isfinite
+
+inline lib::FieldEmitter::~FieldEmitter() noexcept = default;
+
+inline void lib::FieldEmitter::begin_record() {
+  begin_record_impl();
+}
+
+template<class V>
+void lib::FieldEmitter::field(std::string_view name, V const& value)
+{
+  if constexpr (std::is_same_v<V, bool>) {
+    field_impl(name, value);
+  }
+  else if constexpr (std::is_same_v<V, char>) {
+    field_impl(name, std::string_view(&value, 1));
+  }
+  else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+    field_impl(name, static_cast<std::int64_t>(value));
+  }
+  else if constexpr (std::is_integral_v<V>) {
+    field_impl(name, static_cast<std::uint64_t>(value));
+  }
+  else if constexpr (std::is_floating_point_v<V>) {
+    field_impl(name, static_cast<double>(value));
+  }
+  else if constexpr (std::is_convertible_v<V const&, std::string_view>) {
+    field_impl(name, std::string_view(value));
+  }
+  else if constexpr (fmt::is_formattable<V>::value) {
+    formatted_field(name, fmt::make_format_args(value));
+  }
+  else {
+    throw lib::serialization_error{};
+  }
+}
+
+inline void lib::FieldEmitter::end_record() {
+  end_record_impl();
+}
+
+inline void lib::FieldEmitter::formatted_field(std::string_view name,
+                                               fmt::format_args args)
+{
+  field_impl(name, std::string_view(fmt::vformat("{}", args)));
+}
+
+namespace lib::detail {
+
+// Append the representation of the specified arithmetic 'value' to the
+// specified 'buffer', using the shortest representation that round-trips.
+template<class T>
+void append_number(std::string& buffer, T value)
+{
+  char chars[32];
+  auto const end = std::to_chars(chars, chars + sizeof(chars), value).ptr;
+  buffer.append(chars, end);
+}
+
+// Append the specified 'value' to the specified 'buffer' as a JSON string.
+inline void append_json_string(std::string& buffer, std::string_view value)
+{
+  buffer += '"';
+  for (auto const c : value) {
+    switch (c) {
+      case '"':  buffer += "\\\""; break;
+      case '\\': buffer += "\\\\"; break;
+      case '\n': buffer += "\\n";  break;
+      case '\r': buffer += "\\r";  break;
+      case '\t': buffer += "\\t";  break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) { // other control characters
+          char escaped[] = "\\u0000";
+          escaped[4] = "0123456789abcdef"[(c >> 4) & 0xf];
+          escaped[5] = "0123456789abcdef"[c & 0xf];
+          buffer += escaped;
+        }
+        else {
+          buffer += c;
+        }
+    }
+  }
+  buffer += '"';
+}
+
+// Append the specified 'value' to the specified 'buffer' as a CSV value,
+// quoted as per RFC 4180 if needed.
+inline void append_csv_string(std::string& buffer, std::string_view value)
+{
+  if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+    buffer += value;
+    return;
+  }
+  buffer += '"';
+  for (auto const c : value) {
+    if (c == '"') buffer += '"'; // quotes are escaped by doubling them
+    buffer += c;
+  }
+  buffer += '"';
+}
+
+} // namespace lib::detail
+
+// lib::JsonEmitter ///////////////////////////////////////////////////////////
+
+inline lib::JsonEmitter::JsonEmitter(std::string& buffer) noexcept
+: buffer_(buffer)
+{ }
+
+inline void lib::JsonEmitter::begin_record_impl()
+{
+  buffer_ += '{';
+  first_field_ = true;
+}
+
+inline void lib::JsonEmitter::field_impl(std::string_view name, bool value)
+{
+  key(name);
+  buffer_ += value ? "true" : "false";
+}
+
+inline void lib::JsonEmitter::field_impl(std::string_view name,
+                                         std::int64_t value)
+{
+  key(name);
+  lib::detail::append_number(buffer_, value);
+}
+
+inline void lib::JsonEmitter::field_impl(std::string_view name,
+                                         std::uint64_t value)
+{
+  key(name);
+  lib::detail::append_number(buffer_, value);
+}
+
+inline void lib::JsonEmitter::field_impl(std::string_view name, double value)
+{
+  key(name);
+  if (std::isfinite(value)) {
+    lib::detail::append_number(buffer_, value);
+  }
+  else { // not representable in JSON
+    buffer_ += "null";
+  }
+}
+
+inline void lib::JsonEmitter::field_impl(std::string_view name,
+                                         std::string_view value)
+{
+  key(name);
+  lib::detail::append_json_string(buffer_, value);
+}
+
+inline void lib::JsonEmitter::end_record_impl()
+{
+  buffer_ += "}\n";
+}
+
+inline void lib::JsonEmitter::key(std::string_view name)
+{
+  if (!first_field_) buffer_ += ',';
+  first_field_ = false;
+  lib::detail::append_json_string(buffer_, name);
+  buffer_ += ':';
+}
+
+// lib::CsvEmitter ////////////////////////////////////////////////////////////
+
+inline lib::CsvEmitter::CsvEmitter(std::string& buffer, bool header)
+: buffer_(buffer)
+, write_header_(header)
+{ }
+
+inline void lib::CsvEmitter::begin_record_impl()
+{
+  record_begin_ = buffer_.size();
+  first_field_ = true;
+}
+
+inline void lib::CsvEmitter::field_impl(std::string_view name, bool value)
+{
+  separator(name);
+  buffer_ += value ? "true" : "false";
+}
+
+inline void lib::CsvEmitter::field_impl(std::string_view name,
+                                        std::int64_t value)
+{
+  separator(name);
+  lib::detail::append_number(buffer_, value);
+}
+
+inline void lib::CsvEmitter::field_impl(std::string_view name,
+                                        std::uint64_t value)
+{
+  separator(name);
+  lib::detail::append_number(buffer_, value);
+}
+
+inline void lib::CsvEmitter::field_impl(std::string_view name, double value)
+{
+  separator(name);
+  lib::detail::append_number(buffer_, value);
+}
+
+inline void lib::CsvEmitter::field_impl(std::string_view name,
+                                        std::string_view value)
+{
+  separator(name);
+  lib::detail::append_csv_string(buffer_, value);
+}
+
+inline void lib::CsvEmitter::end_record_impl()
+{
+  if (first_field_) return; // no fields, nothing written
+  buffer_ += '\n';
+  if (write_header_) { // the field names are known after the first record
+    header_ += '\n';
+    buffer_.insert(record_begin_, header_);
+    header_ = std::string{};
+    write_header_ = false;
+  }
+}
+
+inline void lib::CsvEmitter::separator(std::string_view name)
+{
+  if (!first_field_) buffer_ += ',';
+  if (write_header_) {
+    if (!first_field_) header_ += ',';
+    lib::detail::append_csv_string(header_, name);
+  }
+  first_field_ = false;
+}
+
+#endif // STRUCTURED_OUTPUT_HPP_INCLUDE_GUARD